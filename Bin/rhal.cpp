@@ -1,6 +1,7 @@
 #include <unistd.h>
 #include <vector>
 #include <iostream>
+#include <fstream>
 #include <tclap/CmdLine.h>
 #include <stdexcept>
 #include <fenv.h>
@@ -18,7 +19,22 @@ int main(int argc, char** argv)
   TCLAP::ValueArg<std::string> protocol("p", "protocol", "Protocol", false, "DynamixelV1", "protocol", cmd);
   TCLAP::ValueArg<std::string> config("c", "config", "Config path", false, "", "filepath", cmd);
   TCLAP::SwitchArg emergencySwitch("e", "emergency", "Broadcast emergency and exit", cmd, false);
+  TCLAP::SwitchArg daemonSwitch("d", "daemon", "Share the Manager with other processes through shared memory", cmd,
+                                false);
+  TCLAP::ValueArg<std::string> shmName("m", "shm", "Shared memory region name", false, "/rhal", "name", cmd);
+  TCLAP::SwitchArg benchSwitch("b", "bench", "Measure bus latency, throughput and error rates and exit", cmd, false);
+  TCLAP::ValueArg<unsigned int> benchIterations("i", "iterations", "Bench transactions per measurement", false, 100,
+                                                "count", cmd);
+  TCLAP::ValueArg<std::string> benchOutput("o", "output", "Bench json output path", false, "", "filepath", cmd);
   cmd.parse(argc, argv);
+  // Negative values wrap when
+  // parsed as unsigned
+  if (benchIterations.getValue() < 1 || benchIterations.getValue() > 1000000)
+  {
+    std::cerr << "Invalid bench iterations: " << benchIterations.getValue() << " (expected 1 to 1000000)"
+              << std::endl;
+    return 1;
+  }
 
   // Creating the manager
   RhAL::StandardManager manager;
@@ -51,6 +67,39 @@ int main(int argc, char** argv)
   std::cout << "Scanning the bus..." << std::endl;
   manager.scan();
 
+  // Bench mode
+  if (benchSwitch.getValue())
+  {
+    std::cout << "Running bus bench..." << std::endl;
+    RhAL::Bench bench(manager, benchIterations.getValue());
+    Json::Value results = bench.run();
+    RhAL::Bench::printTable(std::cout, results);
+    if (benchOutput.getValue() != "")
+    {
+      std::cout << "Writing bench results: " << benchOutput.getValue() << std::endl;
+      std::ofstream file(benchOutput.getValue());
+      if (!file.is_open())
+      {
+        throw std::runtime_error("Unable to open file: " + benchOutput.getValue());
+      }
+      file << results.toStyledString();
+    }
+    return 0;
+  }
+
+  // Daemon mode
+  if (daemonSwitch.getValue())
+  {
+    std::cout << "Exposing Registers in shared memory: " << shmName.getValue() << std::endl;
+    RhAL::SharedMemoryServer server(manager, shmName.getValue());
+    std::cout << "Starting Manager Thread" << std::endl;
+    manager.startManagerThread([&server]() { server.update(); });
+    while (true)
+    {
+      sleep(1);
+    }
+  }
+
   // Start Manager
   std::cout << "Starting Manager Thread" << std::endl;
   manager.startManagerThread();
@@ -0,0 +1,157 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <vector>
+#include <stdexcept>
+#include <tclap/CmdLine.h>
+#include "RhAL.hpp"
+#include "Manager/FlightRecorder.hpp"
+
+/**
+ * Decoded sample of one Register
+ */
+struct Sample
+{
+  double time;
+  double value;
+  RhAL::ResponseState state;
+};
+
+/**
+ * Load Devices definitions from given
+ * RhAL configuration file. Bus and Protocol
+ * configuration are ignored (offline manager).
+ */
+static void loadDevices(RhAL::StandardManager& manager, const std::string& filename)
+{
+  std::ifstream file(filename, std::ios::in | std::ios::binary);
+  if (!file.is_open())
+  {
+    throw std::runtime_error("Unable to read file: " + filename);
+  }
+  std::stringstream contents;
+  contents << file.rdbuf();
+  auto f = Json::Features::all();
+  f.allowComments_ = true;
+  f.strictRoot_ = false;
+  f.allowDroppedNullPlaceholders_ = true;
+  f.allowNumericKeys_ = true;
+  Json::Reader reader(f);
+  Json::Value j;
+  if (!reader.parse(contents.str(), j))
+  {
+    throw std::runtime_error("Error while reading file '" + filename + "' : " + reader.getFormattedErrorMessages());
+  }
+  // Never open the bus nor the recorder
+  j["Manager"]["port"] = "";
+  j["Manager"]["protocol"] = "FakeProtocol";
+  j["Manager"]["recorderPath"] = "";
+  j["Protocol"] = Json::Value(Json::objectValue);
+  manager.loadJSON(j);
+}
+
+/**
+ * Print raw records
+ */
+static void printRaw(const std::vector<RhAL::FlightRecord>& records)
+{
+  std::cout << "# time cycle type id addr length state duration data" << std::endl;
+  for (const RhAL::FlightRecord& rec : records)
+  {
+    std::cout << std::fixed << std::setprecision(6) << rec.time * 1e-9 << " " << rec.cycle << " "
+              << ((rec.type & RhAL::FlightRecordWrite) ? "W" : ((rec.type & RhAL::FlightRecordPing) ? "P" : "R"))
+              << ((rec.type & RhAL::FlightRecordSync) ? "S" : "") << ((rec.type & RhAL::FlightRecordForced) ? "F" : "")
+              << " " << (int)rec.id << " 0x" << std::hex
+              << rec.addr << std::dec << " " << rec.length << " " << rec.state << " " << rec.duration << std::hex;
+    for (size_t i = 0; i < rec.length; i++)
+    {
+      std::cout << " " << std::setw(2) << std::setfill('0') << (int)rec.data[i];
+    }
+    std::cout << std::dec << std::setfill(' ') << std::endl;
+  }
+}
+
+/**
+ * Decode records into per Register time
+ * series using given Manager Devices definitions
+ */
+static void printSeries(const std::vector<RhAL::FlightRecord>& records, const RhAL::StandardManager& manager)
+{
+  // Series indexed by Device name,
+  // Register name and direction
+  std::map<std::string, std::vector<Sample>> series;
+  for (const RhAL::FlightTransaction& rec : RhAL::FlightRecorder::merge(records))
+  {
+    if (!manager.devExists((RhAL::id_t)rec.id))
+    {
+      continue;
+    }
+    const RhAL::Device& dev = manager.dev((RhAL::id_t)rec.id);
+    bool isWrite = rec.type & RhAL::FlightRecordWrite;
+    // Decode all Registers fully
+    // contained in the transaction
+    for (const auto& it : dev.registersList().container())
+    {
+      const RhAL::Register* reg = it.second;
+      if (reg->addr < rec.addr || reg->addr + reg->length > rec.addr + rec.data.size())
+      {
+        continue;
+      }
+      Sample sample;
+      sample.time = rec.time * 1e-9;
+      sample.value = reg->decodeNumber(rec.data.data() + (reg->addr - rec.addr));
+      sample.state = rec.state;
+      series[dev.name() + " " + reg->name + (isWrite ? " write" : " read")].push_back(sample);
+    }
+  }
+  // Print gnuplot blocks
+  for (const auto& it : series)
+  {
+    std::cout << "# " << it.first << std::endl;
+    for (const Sample& sample : it.second)
+    {
+      std::cout << std::fixed << std::setprecision(6) << sample.time << " " << sample.value << " " << sample.state
+                << std::endl;
+    }
+    std::cout << std::endl << std::endl;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  // Reading command line
+  TCLAP::CmdLine cmd("RhAL flight recorder reader", ' ', "0.1");
+  TCLAP::ValueArg<std::string> log("f", "file", "Flight recorder log path", true, "", "filepath", cmd);
+  TCLAP::ValueArg<std::string> config("c", "config", "Config path (Devices definitions)", false, "", "filepath",
+                                      cmd);
+  TCLAP::SwitchArg raw("r", "raw", "Dump raw records", cmd, false);
+  cmd.parse(argc, argv);
+
+  try
+  {
+    // Load the records
+    RhAL::FlightRecorderHeader header;
+    std::vector<RhAL::FlightRecord> records = RhAL::FlightRecorder::load(log.getValue(), header);
+    std::cerr << "Flight recorder: " << records.size() << " records (" << header.count << " appended, capacity "
+              << header.capacity << ")" << std::endl;
+    if (raw.getValue() || config.getValue() == "")
+    {
+      printRaw(records);
+    }
+    else
+    {
+      RhAL::StandardManager manager;
+      loadDevices(manager, config.getValue());
+      printSeries(records, manager);
+    }
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
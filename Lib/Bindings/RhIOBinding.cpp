@@ -1,7 +1,8 @@
 #include <functional>
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
-#include <starkit_utils/stats/stats.h>
+#include <cmath>
 #include "Bindings/RhIOBinding.hpp"
 #include "Manager/BaseManager.hpp"
 #include "Manager/Device.hpp"
@@ -11,9 +12,34 @@
 
 namespace RhAL
 {
-RhIOBinding::RhIOBinding(BaseManager& manager, const std::string& nodeName, bool isUpdateThread)
-  : _thread(nullptr), _isOver(true), _manager(&manager), _node(nullptr)
+RhIOBinding::RhIOBinding(BaseManager& manager, const std::string& nodeName, bool isUpdateThread,
+                         double telemetryFrequency)
+  : _thread(nullptr)
+  , _isOver(true)
+  , _manager(&manager)
+  , _telemetryPeriod(0.0)
+  , _isDevicesChanged(false)
+  , _published()
+  , _dirtyWords(std::make_shared<DirtyWords>())
+  , _unbinds()
+  , _deadbands()
+  , _mutexPublish()
+  , _node(nullptr)
+  , _tareFuture()
+  , _gyroTareFuture()
+  , _tareReport(std::make_shared<std::string>())
+  , _gyroTareReport(std::make_shared<std::string>())
 {
+  if (telemetryFrequency > 0.0)
+  {
+    _telemetryPeriod = 1.0 / telemetryFrequency;
+    // Event driven Devices nodes creation
+    _manager->setCallbackDeviceAdded([this](Device* dev) {
+      (void)dev;
+      this->_isDevicesChanged = true;
+    });
+  }
+
   // Create RhIO Node and retrieve it
   RhIO::Root.newChild(nodeName);
   _node = &(RhIO::Root.child(nodeName));
@@ -50,6 +76,8 @@ RhIOBinding::RhIOBinding(BaseManager& manager, const std::string& nodeName, bool
                     std::bind(&RhIOBinding::cmdTare, this, std::placeholders::_1));
   _node->newCommand("rhalGyroTare", "Tare all gyro devices",
                     std::bind(&RhIOBinding::cmdGyroTare, this, std::placeholders::_1));
+  _node->newCommand("rhalCalibrationStatus", "Display running or last tare results",
+                    std::bind(&RhIOBinding::cmdCalibrationStatus, this, std::placeholders::_1));
 
   // First RhIO/RhAL synchronisation
   update();
@@ -59,10 +87,31 @@ RhIOBinding::RhIOBinding(BaseManager& manager, const std::string& nodeName, bool
   {
     _isOver = false;
     _thread = new std::thread([this]() {
+      TimePoint lastRefresh = getTimePoint();
       while (!this->_isOver)
       {
-        this->update();
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        if (this->_telemetryPeriod > 0.0)
+        {
+          // Create nodes for new Devices
+          if (this->_isDevicesChanged.exchange(false))
+          {
+            this->update();
+          }
+          // Batch publish changed Registers
+          this->publish();
+          // Slow Parameters refresh
+          if (duration_float(lastRefresh, getTimePoint()) >= 0.5)
+          {
+            this->refreshParameters();
+            lastRefresh = getTimePoint();
+          }
+          std::this_thread::sleep_for(TimeDurationFloat(this->_telemetryPeriod));
+        }
+        else
+        {
+          this->update();
+          std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        }
       }
     });
   }
@@ -70,6 +119,10 @@ RhIOBinding::RhIOBinding(BaseManager& manager, const std::string& nodeName, bool
 
 RhIOBinding::~RhIOBinding()
 {
+  if (_telemetryPeriod > 0.0)
+  {
+    _manager->setCallbackDeviceAdded([](Device* dev) { (void)dev; });
+  }
   // Wait for update thread and quit
   if (_thread != nullptr)
   {
@@ -77,10 +130,19 @@ RhIOBinding::~RhIOBinding()
     _thread->join();
     delete _thread;
   }
+  // Reset all installed callbacks since
+  // the Manager may still be running
+  std::lock_guard<std::mutex> lock(_mutexPublish);
+  for (const auto& unbind : _unbinds)
+  {
+    unbind();
+  }
 }
 
 void RhIOBinding::update()
 {
+  std::lock_guard<std::mutex> lock(_mutexPublish);
+
   // Retrive all contained Devices indexed by name
   const auto& allDevices = _manager->devContainer();
 
@@ -116,9 +178,15 @@ void RhIOBinding::update()
         registersNode->newBool(reg.first);
         registersNode->setBool(reg.first, reg.second->readValue().value);
         registersNode->setCallbackBool(reg.first, [reg](bool newValue) { reg.second->writeValue(newValue, true); });
-        auto callback = [registersNode, reg](bool newValue) { registersNode->setBool(reg.first, newValue, true); };
-        reg.second->setCallbackRead(callback);
-        reg.second->setCallbackWrite(callback);
+        if (_telemetryPeriod > 0.0)
+        {
+          addPublished<bool>(registersNode, device.first, reg.first, reg.second, 0);
+        }
+        else
+        {
+          auto callback = [registersNode, reg](bool newValue) { registersNode->setBool(reg.first, newValue, true); };
+          bindRegister<bool>(reg.second, callback, callback);
+        }
       }
     }
     // Iterate over all Registers Int
@@ -131,9 +199,15 @@ void RhIOBinding::update()
         registersNode->newInt(reg.first);
         registersNode->setInt(reg.first, reg.second->readValue().value);
         registersNode->setCallbackInt(reg.first, [reg](long newValue) { reg.second->writeValue(newValue, true); });
-        auto callback = [registersNode, reg](long newValue) { registersNode->setInt(reg.first, newValue, true); };
-        reg.second->setCallbackRead(callback);
-        reg.second->setCallbackWrite(callback);
+        if (_telemetryPeriod > 0.0)
+        {
+          addPublished<int>(registersNode, device.first, reg.first, reg.second, 1);
+        }
+        else
+        {
+          auto callback = [registersNode, reg](long newValue) { registersNode->setInt(reg.first, newValue, true); };
+          bindRegister<int>(reg.second, callback, callback);
+        }
       }
     }
     // Iterate over all Registers Float
@@ -146,9 +220,15 @@ void RhIOBinding::update()
         registersNode->newFloat(reg.first);
         registersNode->setFloat(reg.first, reg.second->readValue().value);
         registersNode->setCallbackFloat(reg.first, [reg](double newValue) { reg.second->writeValue(newValue, true); });
-        auto callback = [registersNode, reg](double newValue) { registersNode->setFloat(reg.first, newValue, true); };
-        reg.second->setCallbackRead(callback);
-        reg.second->setCallbackWrite(callback);
+        if (_telemetryPeriod > 0.0)
+        {
+          addPublished<float>(registersNode, device.first, reg.first, reg.second, 2);
+        }
+        else
+        {
+          auto callback = [registersNode, reg](double newValue) { registersNode->setFloat(reg.first, newValue, true); };
+          bindRegister<float>(reg.second, callback, callback);
+        }
       }
     }
     // Create parameters RhIO node if not exists
@@ -158,7 +238,8 @@ void RhIOBinding::update()
     }
     RhIO::IONode* parametersNode = &(deviceNode->child("parameters"));
     // Update all parameters
-    updateParameters(device.second->parametersList(), parametersNode);
+    Device* dev = device.second;
+    updateParameters(dev->parametersList(), parametersNode, [dev]() { dev->onParametersUpdate(); });
     // Specific updates
     specificUpdate(deviceNode, device.second);
   }
@@ -182,6 +263,123 @@ void RhIOBinding::update()
   updateParameters(_manager->protocolParametersList(), parametersProtocolNode);
 }
 
+void RhIOBinding::publish()
+{
+  std::lock_guard<std::mutex> lock(_mutexPublish);
+  for (size_t w = 0; w < _dirtyWords->read.size(); w++)
+  {
+    uint64_t bitsRead = _dirtyWords->read[w].exchange(0, std::memory_order_relaxed);
+    uint64_t bitsWrite = _dirtyWords->write[w].exchange(0, std::memory_order_relaxed);
+    uint64_t bits = bitsRead | bitsWrite;
+    while (bits != 0)
+    {
+      size_t bit = __builtin_ctzll(bits);
+      bits &= bits - 1;
+      Published& pub = _published[w * 64 + bit];
+      // Retrieve last value without bus access.
+      // Registers only changed by the user (write
+      // only Registers) publish the commanded value.
+      bool isWritten = !(bitsRead & ((uint64_t)1 << bit));
+      double value;
+      if (pub.type == 0)
+      {
+        TypedRegister<bool>* reg = static_cast<TypedRegister<bool>*>(pub.reg);
+        value = isWritten ? reg->getWrittenValue() : reg->readValue(true).value;
+      }
+      else if (pub.type == 1)
+      {
+        TypedRegister<int>* reg = static_cast<TypedRegister<int>*>(pub.reg);
+        value = isWritten ? reg->getWrittenValue() : reg->readValue(true).value;
+      }
+      else
+      {
+        TypedRegister<float>* reg = static_cast<TypedRegister<float>*>(pub.reg);
+        value = isWritten ? reg->getWrittenValue() : reg->readValue(true).value;
+      }
+      // Apply deadband
+      if (pub.isPublished && std::fabs(value - pub.lastValue) <= pub.deadband)
+      {
+        continue;
+      }
+      pub.isPublished = true;
+      pub.lastValue = value;
+      if (pub.type == 0)
+      {
+        pub.node->setBool(pub.name, (bool)value, true);
+      }
+      else if (pub.type == 1)
+      {
+        pub.node->setInt(pub.name, (long)value, true);
+      }
+      else
+      {
+        pub.node->setFloat(pub.name, value, true);
+      }
+    }
+  }
+}
+
+void RhIOBinding::setTelemetryDeadband(const std::string& devName, const std::string& regName, double deadband)
+{
+  std::lock_guard<std::mutex> lock(_mutexPublish);
+  std::string key = devName + "/" + regName;
+  _deadbands[key] = deadband;
+  for (Published& pub : _published)
+  {
+    if (pub.key == key)
+    {
+      pub.deadband = deadband;
+    }
+  }
+}
+
+template <typename T>
+void RhIOBinding::addPublished(RhIO::IONode* node, const std::string& devName, const std::string& name,
+                               TypedRegister<T>* reg, int type)
+{
+  size_t index = _published.size();
+  std::string key = devName + "/" + name;
+  double deadband = 0.0;
+  if (_deadbands.count(key) > 0)
+  {
+    deadband = _deadbands.at(key);
+  }
+  _published.push_back(Published{ reg, node, name, key, type, deadband, 0.0, false });
+  if (index / 64 >= _dirtyWords->read.size())
+  {
+    _dirtyWords->read.emplace_back(0);
+    _dirtyWords->write.emplace_back(0);
+  }
+  // Only mark the Register as changed. Callbacks
+  // hold the dirty words alive and only access
+  // their own (address stable) word.
+  std::shared_ptr<DirtyWords> dirty = _dirtyWords;
+  std::atomic<uint64_t>* wordRead = &_dirtyWords->read[index / 64];
+  std::atomic<uint64_t>* wordWrite = &_dirtyWords->write[index / 64];
+  uint64_t mask = (uint64_t)1 << (index % 64);
+  bindRegister<T>(reg,
+                  [dirty, wordRead, mask](T newValue) {
+                    (void)newValue;
+                    wordRead->fetch_or(mask, std::memory_order_relaxed);
+                  },
+                  [dirty, wordWrite, mask](T newValue) {
+                    (void)newValue;
+                    wordWrite->fetch_or(mask, std::memory_order_relaxed);
+                  });
+}
+
+template <typename T>
+void RhIOBinding::bindRegister(TypedRegister<T>* reg, std::function<void(T)> callbackRead,
+                               std::function<void(T)> callbackWrite)
+{
+  reg->setCallbackRead(callbackRead);
+  reg->setCallbackWrite(callbackWrite);
+  _unbinds.push_back([reg]() {
+    reg->setCallbackRead([](T val) { (void)val; });
+    reg->setCallbackWrite([](T val) { (void)val; });
+  });
+}
+
 void RhIOBinding::specificUpdate(RhIO::IONode* deviceNode, RhAL::Device* device)
 {
   // If the device is a GY85
@@ -260,6 +458,7 @@ void RhIOBinding::specificUpdate(RhIO::IONode* deviceNode, RhAL::Device* device)
       };
       update();
       gy85->setCallback(update);
+      _unbinds.push_back([gy85]() { gy85->setCallback([]() {}); });
     }
   }
   // Pressure sensors
@@ -278,11 +477,39 @@ void RhIOBinding::specificUpdate(RhIO::IONode* deviceNode, RhAL::Device* device)
       };
       update();
       ps->setCallback(update);
+      _unbinds.push_back([ps]() { ps->setCallback([]() {}); });
+    }
+  }
+}
+
+void RhIOBinding::refreshParameters()
+{
+  for (const auto& device : _manager->devContainer())
+  {
+    if (!_node->childExist(device.first))
+    {
+      continue;
     }
+    RhIO::IONode* deviceNode = &(_node->child(device.first));
+    if (!deviceNode->childExist("parameters"))
+    {
+      continue;
+    }
+    Device* dev = device.second;
+    updateParameters(dev->parametersList(), &(deviceNode->child("parameters")),
+                     [dev]() { dev->onParametersUpdate(); });
+  }
+  if (_node->childExist("Manager"))
+  {
+    updateParameters(_manager->parametersList(), &(_node->child("Manager")));
+  }
+  if (_node->childExist("Protocol"))
+  {
+    updateParameters(_manager->protocolParametersList(), &(_node->child("Protocol")));
   }
 }
 
-void RhIOBinding::updateParameters(ParametersList& params, RhIO::IONode* node)
+void RhIOBinding::updateParameters(ParametersList& params, RhIO::IONode* node, std::function<void()> onUpdate)
 {
   // Iterate over all parameters of type Bool and exportation to RhIO
   for (const auto& param : params.containerBool())
@@ -291,7 +518,13 @@ void RhIOBinding::updateParameters(ParametersList& params, RhIO::IONode* node)
     {
       node->newBool(param.first);
       node->setBool(param.first, param.second->value);
-      node->setCallbackBool(param.first, [param](bool newValue) { param.second->value = newValue; });
+      node->setCallbackBool(param.first, [param, onUpdate](bool newValue) {
+        param.second->value = newValue;
+        if (onUpdate)
+        {
+          onUpdate();
+        }
+      });
     }
     else
     {
@@ -305,7 +538,13 @@ void RhIOBinding::updateParameters(ParametersList& params, RhIO::IONode* node)
     {
       node->newFloat(param.first);
       node->setFloat(param.first, param.second->value);
-      node->setCallbackFloat(param.first, [param](double newValue) { param.second->value = newValue; });
+      node->setCallbackFloat(param.first, [param, onUpdate](double newValue) {
+        param.second->value = newValue;
+        if (onUpdate)
+        {
+          onUpdate();
+        }
+      });
     }
     else
     {
@@ -319,7 +558,13 @@ void RhIOBinding::updateParameters(ParametersList& params, RhIO::IONode* node)
     {
       node->newStr(param.first);
       node->setStr(param.first, param.second->value);
-      node->setCallbackStr(param.first, [param](std::string newValue) { param.second->value = newValue; });
+      node->setCallbackStr(param.first, [param, onUpdate](std::string newValue) {
+        param.second->value = newValue;
+        if (onUpdate)
+        {
+          onUpdate();
+        }
+      });
     }
     else
     {
@@ -595,11 +840,49 @@ std::string RhIOBinding::cmdChangeId(std::vector<std::string> argv)
   return "Change id from" + argv[0] + " to " + argv[1] + ". RhAL Exit.";
 }
 
+/**
+ * Return true if given calibration
+ * future is still running
+ */
+static bool isCalibrationRunning(const std::shared_future<CalibrationResult>& future)
+{
+  return future.valid() && future.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+/**
+ * Return the status of given calibration
+ * future with its report once done
+ */
+static std::string calibrationStatus(const std::shared_future<CalibrationResult>& future, const std::string& report)
+{
+  if (!future.valid())
+  {
+    return "never run";
+  }
+  if (isCalibrationRunning(future))
+  {
+    return "running";
+  }
+  try
+  {
+    future.get();
+  }
+  catch (const std::exception& e)
+  {
+    return "\nError: " + std::string(e.what());
+  }
+  return "\n" + report;
+}
+
 std::string RhIOBinding::cmdTare(std::vector<std::string> argv)
 {
   (void)argv;
+  if (isCalibrationRunning(_tareFuture))
+  {
+    return "Tare already running";
+  }
   std::vector<PressureSensorBase*> sensors;
-  std::map<PressureSensorBase*, std::vector<std::vector<double>>> zeros;
+  size_t channels = 0;
   const auto& allDevices = _manager->devContainer();
   for (const auto& dev : allDevices)
   {
@@ -607,12 +890,11 @@ std::string RhIOBinding::cmdTare(std::vector<std::string> argv)
     if (ps != nullptr)
     {
       sensors.push_back(ps);
-      zeros[ps] = std::vector<std::vector<double>>();
       for (int g = 0; g < ps->gauges(); g++)
       {
         // Reseting the zeros
         ps->setZero(g, 0);
-        zeros[ps].push_back(std::vector<double>());
+        channels++;
       }
     }
   }
@@ -621,61 +903,59 @@ std::string RhIOBinding::cmdTare(std::vector<std::string> argv)
   {
     return "No pressure devices found";
   }
-  else
-  {
-    _manager->waitNextFlush();
-    std::stringstream ss;
-    int samples = 250;
-    for (int k = 0; k < samples; k++)
+
+  // All gauges are sampled at each flush
+  // and the zeros are applied by the Manager
+  std::shared_ptr<std::string> report = _tareReport;
+  auto sample = [sensors](double* values) -> bool {
+    for (const auto& ps : sensors)
     {
-      for (const auto& ps : sensors)
+      for (int g = 0; g < ps->gauges(); g++)
       {
-        for (int g = 0; g < ps->gauges(); g++)
-        {
-          zeros[ps][g].push_back(ps->gain(g) * ps->pressure(g));
-        }
+        *values++ = ps->gain(g) * ps->pressure(g).readValue(true).value;
       }
-      _manager->waitNextFlush();
     }
-    std::vector<std::string> errors;
+    return true;
+  };
+  auto apply = [sensors, report](const CalibrationResult& result) {
+    std::stringstream ss;
+    ss.precision(30);
+    size_t index = 0;
     for (const auto& ps : sensors)
     {
-      ss.precision(30);
       for (int g = 0; g < ps->gauges(); g++)
       {
-        double avg;
-        double dev = starkit_utils::standardDeviation(zeros[ps][g], &avg);
+        double avg = result.means[index];
+        double dev = result.deviations[index];
+        index++;
         if (dev > ps->getMaxStdDev())
         {
-          std::stringstream tmp;
-          tmp << "Too high deviation for " << ps->name() << " #" << g << " (" << dev << " > " << ps->getMaxStdDev()
-              << ")";
-          errors.push_back(tmp.str());
+          ss << "Error: Too high deviation for " << ps->name() << " #" << g << " (" << dev << " > "
+             << ps->getMaxStdDev() << ")" << std::endl;
         }
         if (dev < ps->getMinStdDev())
         {
-          std::stringstream tmp;
-          tmp << "Too low deviation  for " << ps->name() << " #" << g;
-          errors.push_back(tmp.str());
+          ss << "Error: Too low deviation  for " << ps->name() << " #" << g << std::endl;
         }
         ps->setZero(g, avg);
       }
     }
-    for (auto& err : errors)
-    {
-      ss << "Error: " << err << std::endl;
-    }
     ss << "Tare on " << sensors.size() << " devices.";
-    return ss.str();
-  }
+    *report = ss.str();
+  };
+  _tareFuture = _manager->calibrator().start(channels, 250, sample, apply, 1, 1000);
+
+  return "Tare started on " + std::to_string(sensors.size()) + " devices (see rhalCalibrationStatus)";
 }
 
 std::string RhIOBinding::cmdGyroTare(std::vector<std::string> argv)
 {
   (void)argv;
+  if (isCalibrationRunning(_gyroTareFuture))
+  {
+    return "Gyro tare already running";
+  }
   std::vector<GY85*> sensors;
-  std::map<GY85*, std::map<std::string, std::vector<double>>> zeros;
-
   auto allDevices = _manager->devContainer();
   for (auto& dev : allDevices)
   {
@@ -683,10 +963,6 @@ std::string RhIOBinding::cmdGyroTare(std::vector<std::string> argv)
     if (gy85 != nullptr)
     {
       sensors.push_back(gy85);
-      zeros[gy85] = std::map<std::string, std::vector<double>>();
-      zeros[gy85]["x"] = std::vector<double>();
-      zeros[gy85]["y"] = std::vector<double>();
-      zeros[gy85]["z"] = std::vector<double>();
     }
   }
 
@@ -694,47 +970,68 @@ std::string RhIOBinding::cmdGyroTare(std::vector<std::string> argv)
   {
     return "No sensor found";
   }
-  else
-  {
-    std::stringstream ss;
-    int samples = 300;
-    for (int k = 0; k < samples; k++)
+
+  // The newest raw sample of each sensor is
+  // taken at each flush where one of them has
+  // new samples, the others keep their last one
+  std::shared_ptr<std::string> report = _gyroTareReport;
+  std::shared_ptr<std::vector<double>> lasts = std::make_shared<std::vector<double>>(3 * sensors.size());
+  std::shared_ptr<std::vector<bool>> isSeens = std::make_shared<std::vector<bool>>(sensors.size(), false);
+  auto sample = [sensors, lasts, isSeens](double* values) -> bool {
+    bool isNew = false;
+    bool isAllSeen = true;
+    for (size_t i = 0; i < sensors.size(); i++)
     {
-      for (auto& gy85 : sensors)
+      const auto& batch = sensors[i]->stream().batch();
+      if (!batch.empty())
       {
-        zeros[gy85]["x"].push_back(gy85->getGyroXRaw());
-        zeros[gy85]["y"].push_back(gy85->getGyroYRaw());
-        zeros[gy85]["z"].push_back(gy85->getGyroZRaw());
+        const GY85::GY85Value& value = batch.back().value;
+        (*lasts)[3 * i] = value.gyroX;
+        (*lasts)[3 * i + 1] = value.gyroY;
+        (*lasts)[3 * i + 2] = value.gyroZ;
+        (*isSeens)[i] = true;
+        isNew = true;
       }
-      _manager->waitNextFlush();
+      isAllSeen = isAllSeen && (*isSeens)[i];
     }
-    for (auto& gy85 : sensors)
+    if (!isNew || !isAllSeen)
     {
-      double xAvg, xDev;
-      xDev = starkit_utils::standardDeviation(zeros[gy85]["x"], &xAvg);
-      double yAvg, yDev;
-      yDev = starkit_utils::standardDeviation(zeros[gy85]["y"], &yAvg);
-      double zAvg, zDev;
-      zDev = starkit_utils::standardDeviation(zeros[gy85]["z"], &zAvg);
-
-      if (xDev > gy85->getMaxStdDev())
-      {
-        ss << "Error: too high deviation for X (" << xDev << ")" << std::endl;
-      }
-      if (yDev > gy85->getMaxStdDev())
-      {
-        ss << "Error: too high deviation for Y (" << yDev << ")" << std::endl;
-      }
-      if (zDev > gy85->getMaxStdDev())
+      return false;
+    }
+    std::copy(lasts->begin(), lasts->end(), values);
+    return true;
+  };
+  auto apply = [sensors, report](const CalibrationResult& result) {
+    std::stringstream ss;
+    for (size_t i = 0; i < sensors.size(); i++)
+    {
+      GY85* gy85 = sensors[i];
+      const char* axis[3] = { "X", "Y", "Z" };
+      for (size_t k = 0; k < 3; k++)
       {
-        ss << "Error: too high deviation for Z (" << zDev << ")" << std::endl;
+        double dev = result.deviations[3 * i + k];
+        if (dev > gy85->getMaxStdDev())
+        {
+          ss << "Error: too high deviation for " << axis[k] << " (" << dev << ")" << std::endl;
+        }
       }
-
-      gy85->setGyroCalibration(xAvg, yAvg, zAvg);
+      gy85->setGyroCalibration(result.means[3 * i], result.means[3 * i + 1], result.means[3 * i + 2]);
     }
     ss << "Done.";
-    return ss.str();
-  }
+    *report = ss.str();
+  };
+  _gyroTareFuture = _manager->calibrator().start(3 * sensors.size(), 300, sample, apply, 0, 1200);
+
+  return "Gyro tare started on " + std::to_string(sensors.size()) + " devices (see rhalCalibrationStatus)";
+}
+
+std::string RhIOBinding::cmdCalibrationStatus(std::vector<std::string> argv)
+{
+  (void)argv;
+  std::stringstream ss;
+  ss << "Tare: " << calibrationStatus(_tareFuture, *_tareReport);
+  ss << std::endl << "Gyro tare: " << calibrationStatus(_gyroTareFuture, *_gyroTareReport);
+  return ss.str();
 }
 
 }  // namespace RhAL
@@ -1,15 +1,26 @@
 #pragma once
 
 #include <thread>
+#include <functional>
 #include <vector>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <atomic>
 #include <string>
+#include <memory>
+#include <future>
 #include <RhIO.hpp>
+#include "Manager/Calibrator.hpp"
 
 namespace RhAL
 {
 class BaseManager;
 class ParametersList;
 class Device;
+class Register;
+template <typename T>
+class TypedRegister;
 
 /**
  * RhIOBinding
@@ -26,8 +37,15 @@ public:
    * nodeName: RhIO node name for RhAL.
    * isUpdateThread: if true, a thread periodicaly
    * check for new Devices/Parameters.
+   * telemetryFrequency: if 0, Registers changes are
+   * pushed immediately to RhIO. Else, changed Registers
+   * are only marked and published in one batch at given
+   * frequency (in Hz) by the update thread, and new Devices
+   * nodes are created on Manager device add events
+   * instead of periodic polling.
    */
-  RhIOBinding(BaseManager& manager, const std::string& nodeName = "lowlevel", bool isUpdateThread = true);
+  RhIOBinding(BaseManager& manager, const std::string& nodeName = "lowlevel", bool isUpdateThread = true,
+              double telemetryFrequency = 0.0);
 
   /**
    * Destructor
@@ -42,6 +60,20 @@ public:
    */
   void update();
 
+  /**
+   * Publish to RhIO all Registers marked
+   * as changed since last call.
+   * (Telemetry mode only)
+   */
+  void publish();
+
+  /**
+   * Set the minimum absolute change of given
+   * Device name and Register name value to be
+   * published in telemetry mode (0 by default)
+   */
+  void setTelemetryDeadband(const std::string& devName, const std::string& regName, double deadband);
+
   /**
    * Doing specific updates
    * on float registers.
@@ -66,6 +98,7 @@ public:
   std::string cmdChangeId(std::vector<std::string> argv);
   std::string cmdTare(std::vector<std::string> argv);
   std::string cmdGyroTare(std::vector<std::string> argv);
+  std::string cmdCalibrationStatus(std::vector<std::string> argv);
   std::string cmdInit(std::vector<std::string> argv);
 
 private:
@@ -80,15 +113,118 @@ private:
    */
   BaseManager* _manager;
 
+  /**
+   * Telemetry publishing period in seconds
+   * (0 if changes are pushed immediately)
+   */
+  double _telemetryPeriod;
+
+  /**
+   * Set by Manager on Device add,
+   * the binding has to be updated
+   */
+  std::atomic<bool> _isDevicesChanged;
+
+  /**
+   * Register published in telemetry mode.
+   * Type is 0 for bool, 1 for int and 2 for float
+   */
+  struct Published
+  {
+    Register* reg;
+    RhIO::IONode* node;
+    std::string name;
+    std::string key;
+    int type;
+    double deadband;
+    double lastValue;
+    bool isPublished;
+  };
+
+  /**
+   * Dirty bits of published Registers (one bit
+   * per Published index) set by Register read and
+   * write callbacks without locking. Deques keep
+   * elements address stable while growing.
+   * Shared with the installed callbacks which
+   * may outlive the binding.
+   */
+  struct DirtyWords
+  {
+    std::deque<std::atomic<uint64_t>> read;
+    std::deque<std::atomic<uint64_t>> write;
+  };
+
+  /**
+   * Published Registers and their dirty bits
+   */
+  std::deque<Published> _published;
+  std::shared_ptr<DirtyWords> _dirtyWords;
+
+  /**
+   * Reset functions of all Registers and
+   * Devices callbacks installed by the binding
+   * (called at destruction)
+   */
+  std::vector<std::function<void()>> _unbinds;
+
+  /**
+   * User deadbands indexed by
+   * Device name / Register name
+   */
+  std::map<std::string, double> _deadbands;
+
+  /**
+   * Mutex protecting published
+   * Registers containers
+   */
+  std::mutex _mutexPublish;
+
   /**
    * Pointer to RhIO node
    */
   RhIO::IONode* _node;
 
   /**
-   * Update RhIO on given RhAL ParameterList
+   * Running or last tare and gyro tare
+   * calibrations and their textual reports
+   * (written by the Manager when the
+   * calibration completes)
+   */
+  std::shared_future<CalibrationResult> _tareFuture;
+  std::shared_future<CalibrationResult> _gyroTareFuture;
+  std::shared_ptr<std::string> _tareReport;
+  std::shared_ptr<std::string> _gyroTareReport;
+
+  /**
+   * Update RhIO on given RhAL ParameterList.
+   * Optional onUpdate is called after any
+   * parameter is changed from RhIO.
+   */
+  void updateParameters(ParametersList& params, RhIO::IONode* node, std::function<void()> onUpdate = nullptr);
+
+  /**
+   * Update RhIO on all Devices, Manager
+   * and Protocol Parameters
+   * (Telemetry mode periodic refresh)
+   */
+  void refreshParameters();
+
+  /**
+   * Add given Register to published Registers
+   * and install its read and write callbacks
+   * marking it as changed
+   */
+  template <typename T>
+  void addPublished(RhIO::IONode* node, const std::string& devName, const std::string& name, TypedRegister<T>* reg,
+                    int type);
+
+  /**
+   * Install given read and write callback on
+   * given Register and record its reset
    */
-  void updateParameters(ParametersList& params, RhIO::IONode* node);
+  template <typename T>
+  void bindRegister(TypedRegister<T>* reg, std::function<void(T)> callbackRead, std::function<void(T)> callbackWrite);
 };
 
 }  // namespace RhAL
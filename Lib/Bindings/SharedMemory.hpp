@@ -0,0 +1,179 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+namespace RhAL
+{
+/**
+ * Shared memory region format version
+ * and fixed names length
+ */
+constexpr uint32_t SharedMemoryVersion = 2;
+constexpr size_t SharedNameLen = 48;
+
+/**
+ * Shared Register value type
+ */
+enum : uint8_t
+{
+  SharedTypeBool = 0,
+  SharedTypeInt = 1,
+  SharedTypeFloat = 2,
+};
+
+/**
+ * Shared write ring request kind
+ */
+enum : uint32_t
+{
+  // Write the request value
+  SharedRequestWrite = 0,
+  // Ask a read at next flush
+  SharedRequestRead = 1,
+};
+
+/**
+ * SharedMemoryHeader
+ *
+ * Region header. Epoch is incremented by
+ * the server after each publication.
+ * The region is laid out as: header, registers
+ * infos, registers slots and write ring cells.
+ * Slots and ring start on a cache line boundary
+ * (the region itself is page aligned).
+ */
+struct SharedMemoryHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t registerCount;
+  uint32_t ringCapacity;
+  uint32_t reserved;
+  std::atomic<uint64_t> epoch;
+  std::atomic<uint64_t> enqueuePos;
+  std::atomic<uint64_t> dequeuePos;
+  std::atomic<int64_t> heartbeat;
+};
+
+/**
+ * SharedRegisterInfo
+ *
+ * Static description of one
+ * Register (written once by the server)
+ */
+struct SharedRegisterInfo
+{
+  int32_t id;
+  uint8_t type;
+  uint8_t isReadOnly;
+  uint8_t reserved[2];
+  char device[SharedNameLen];
+  char name[SharedNameLen];
+};
+
+/**
+ * SharedRegisterSlot
+ *
+ * Last read value (as double bits),
+ * timestamp (steady clock nanoseconds) and
+ * error flag of one Register. Single writer
+ * sequence lock: the sequence is odd while
+ * the server is updating the slot.
+ */
+struct alignas(64) SharedRegisterSlot
+{
+  std::atomic<uint32_t> sequence;
+  std::atomic<uint32_t> isError;
+  std::atomic<uint64_t> value;
+  std::atomic<int64_t> timestamp;
+};
+
+/**
+ * SharedRequestCell
+ *
+ * Write ring cell (bounded multiple producers
+ * queue, sequence numbered cells)
+ */
+struct SharedRequestCell
+{
+  std::atomic<uint64_t> sequence;
+  uint32_t slot;
+  uint32_t kind;
+  double value;
+};
+
+/**
+ * Region magic
+ */
+static constexpr char SharedMemoryMagic[8] = { 'R', 'H', 'A', 'L', 'S', 'H', 'M', '1' };
+
+/**
+ * Return given offset rounded
+ * up to a cache line boundary
+ */
+inline size_t sharedAlign(size_t offset)
+{
+  return (offset + alignof(SharedRegisterSlot) - 1) & ~(alignof(SharedRegisterSlot) - 1);
+}
+
+/**
+ * Return the offset in bytes of region
+ * parts for given number of Registers
+ */
+inline size_t sharedSlotsOffset(size_t registerCount)
+{
+  return sharedAlign(sizeof(SharedMemoryHeader) + registerCount * sizeof(SharedRegisterInfo));
+}
+inline size_t sharedRingOffset(size_t registerCount)
+{
+  return sharedAlign(sharedSlotsOffset(registerCount) + registerCount * sizeof(SharedRegisterSlot));
+}
+
+/**
+ * Return the region size in bytes for given
+ * number of Registers and ring capacity
+ */
+inline size_t sharedMemorySize(size_t registerCount, size_t ringCapacity)
+{
+  return sharedRingOffset(registerCount) + ringCapacity * sizeof(SharedRequestCell);
+}
+
+/**
+ * Return the address of region parts
+ */
+inline SharedRegisterInfo* sharedInfos(void* region)
+{
+  return (SharedRegisterInfo*)((uint8_t*)region + sizeof(SharedMemoryHeader));
+}
+inline SharedRegisterSlot* sharedSlots(void* region, size_t registerCount)
+{
+  return (SharedRegisterSlot*)((uint8_t*)region + sharedSlotsOffset(registerCount));
+}
+inline SharedRequestCell* sharedRing(void* region, size_t registerCount)
+{
+  return (SharedRequestCell*)((uint8_t*)region + sharedRingOffset(registerCount));
+}
+
+/**
+ * Double bits conversion
+ */
+inline uint64_t sharedToBits(double value)
+{
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+inline double sharedFromBits(uint64_t bits)
+{
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+static_assert(sizeof(SharedRegisterInfo) % 8 == 0, "SharedRegisterInfo layout");
+static_assert(sizeof(SharedRegisterSlot) == 64, "SharedRegisterSlot layout");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared memory needs lock free 64 bits atomics");
+
+}  // namespace RhAL
@@ -0,0 +1,240 @@
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <stdexcept>
+#include "Bindings/SharedMemoryClient.hpp"
+
+namespace RhAL
+{
+template <typename T>
+SharedTypedRegister<T>::SharedTypedRegister(SharedMemoryClient& client, size_t index) : _client(&client), _index(index)
+{
+}
+
+template <typename T>
+ReadValue<T> SharedTypedRegister<T>::readValue() const
+{
+  double value;
+  TimePoint timestamp;
+  bool isError;
+  _client->load(_index, value, timestamp, isError);
+  return ReadValue<T>(timestamp, (T)value, isError);
+}
+
+template <>
+ReadValue<bool> SharedTypedRegister<bool>::readValue() const
+{
+  double value;
+  TimePoint timestamp;
+  bool isError;
+  _client->load(_index, value, timestamp, isError);
+  return ReadValue<bool>(timestamp, value != 0.0, isError);
+}
+
+template <typename T>
+void SharedTypedRegister<T>::writeValue(T val)
+{
+  if (_client->_infos[_index].isReadOnly)
+  {
+    throw std::logic_error("SharedTypedRegister write on read only register: " + name());
+  }
+  if (!_client->push(_index, SharedRequestWrite, val))
+  {
+    throw std::runtime_error("SharedTypedRegister request ring full: " + name());
+  }
+}
+
+template <typename T>
+void SharedTypedRegister<T>::askRead()
+{
+  if (!_client->push(_index, SharedRequestRead, 0.0))
+  {
+    throw std::runtime_error("SharedTypedRegister request ring full: " + name());
+  }
+}
+
+template <typename T>
+std::string SharedTypedRegister<T>::deviceName() const
+{
+  return std::string(_client->_infos[_index].device);
+}
+template <typename T>
+std::string SharedTypedRegister<T>::name() const
+{
+  return std::string(_client->_infos[_index].name);
+}
+template <typename T>
+id_t SharedTypedRegister<T>::id() const
+{
+  return _client->_infos[_index].id;
+}
+template <typename T>
+bool SharedTypedRegister<T>::isReadOnly() const
+{
+  return _client->_infos[_index].isReadOnly;
+}
+
+/**
+ * Template instantiation
+ */
+template class SharedTypedRegister<bool>;
+template class SharedTypedRegister<int>;
+template class SharedTypedRegister<float>;
+
+SharedMemoryClient::SharedMemoryClient(const std::string& name)
+  : _region(nullptr)
+  , _size(0)
+  , _header(nullptr)
+  , _infos(nullptr)
+  , _slots(nullptr)
+  , _ring(nullptr)
+  , _ringMask(0)
+{
+  int fd = shm_open(name.c_str(), O_RDWR, 0);
+  if (fd == -1)
+  {
+    throw std::runtime_error("SharedMemoryClient unable to open region: " + name + ": " + std::strerror(errno));
+  }
+  struct stat st;
+  if (fstat(fd, &st) == -1 || (size_t)st.st_size < sizeof(SharedMemoryHeader))
+  {
+    close(fd);
+    throw std::runtime_error("SharedMemoryClient invalid region: " + name);
+  }
+  _size = st.st_size;
+  _region = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (_region == MAP_FAILED)
+  {
+    throw std::runtime_error("SharedMemoryClient unable to map region: " + name + ": " + std::strerror(errno));
+  }
+  _header = (SharedMemoryHeader*)_region;
+  if (std::memcmp(_header->magic, SharedMemoryMagic, sizeof(SharedMemoryMagic)) != 0 ||
+      _header->version != SharedMemoryVersion ||
+      sharedMemorySize(_header->registerCount, _header->ringCapacity) != _size)
+  {
+    munmap(_region, _size);
+    throw std::runtime_error("SharedMemoryClient invalid region: " + name);
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  _infos = sharedInfos(_region);
+  _slots = sharedSlots(_region, _header->registerCount);
+  _ring = sharedRing(_region, _header->registerCount);
+  _ringMask = _header->ringCapacity - 1;
+}
+
+SharedMemoryClient::~SharedMemoryClient()
+{
+  munmap(_region, _size);
+}
+
+SharedTypedRegisterBool SharedMemoryClient::regBool(const std::string& devName, const std::string& regName)
+{
+  return SharedTypedRegisterBool(*this, find(devName, regName, SharedTypeBool));
+}
+SharedTypedRegisterInt SharedMemoryClient::regInt(const std::string& devName, const std::string& regName)
+{
+  return SharedTypedRegisterInt(*this, find(devName, regName, SharedTypeInt));
+}
+SharedTypedRegisterFloat SharedMemoryClient::regFloat(const std::string& devName, const std::string& regName)
+{
+  return SharedTypedRegisterFloat(*this, find(devName, regName, SharedTypeFloat));
+}
+
+size_t SharedMemoryClient::count() const
+{
+  return _header->registerCount;
+}
+
+uint64_t SharedMemoryClient::epoch() const
+{
+  return _header->epoch.load(std::memory_order_acquire);
+}
+
+bool SharedMemoryClient::isAlive(double timeout) const
+{
+  if (std::memcmp(_header->magic, SharedMemoryMagic, sizeof(SharedMemoryMagic)) != 0)
+  {
+    return false;
+  }
+  int64_t now =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+          .count();
+  return now - _header->heartbeat.load(std::memory_order_relaxed) <= (int64_t)(timeout * 1e9);
+}
+
+size_t SharedMemoryClient::find(const std::string& devName, const std::string& regName, uint8_t type) const
+{
+  for (size_t i = 0; i < _header->registerCount; i++)
+  {
+    if (devName == _infos[i].device && regName == _infos[i].name)
+    {
+      if (_infos[i].type != type)
+      {
+        throw std::logic_error("SharedMemoryClient register type mismatch: " + devName + "/" + regName);
+      }
+      return i;
+    }
+  }
+  throw std::logic_error("SharedMemoryClient register not found: " + devName + "/" + regName);
+}
+
+void SharedMemoryClient::load(size_t index, double& value, TimePoint& timestamp, bool& isError) const
+{
+  const SharedRegisterSlot& slot = _slots[index];
+  while (true)
+  {
+    uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+    uint64_t bits = slot.value.load(std::memory_order_relaxed);
+    int64_t time = slot.timestamp.load(std::memory_order_relaxed);
+    uint32_t flag = slot.isError.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // Retry if the server was
+    // updating the slot
+    if ((sequence & 1) == 0 && slot.sequence.load(std::memory_order_relaxed) == sequence)
+    {
+      value = sharedFromBits(bits);
+      timestamp = TimePoint(std::chrono::nanoseconds(time));
+      isError = flag;
+      return;
+    }
+  }
+}
+
+bool SharedMemoryClient::push(size_t index, uint32_t kind, double value)
+{
+  uint64_t pos = _header->enqueuePos.load(std::memory_order_relaxed);
+  SharedRequestCell* cell;
+  while (true)
+  {
+    cell = &_ring[pos & _ringMask];
+    uint64_t sequence = cell->sequence.load(std::memory_order_acquire);
+    int64_t diff = (int64_t)sequence - (int64_t)pos;
+    if (diff == 0)
+    {
+      // Claim the cell
+      if (_header->enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+      {
+        break;
+      }
+    }
+    else if (diff < 0)
+    {
+      // Full ring
+      return false;
+    }
+    else
+    {
+      pos = _header->enqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+  cell->slot = index;
+  cell->kind = kind;
+  cell->value = value;
+  cell->sequence.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+}  // namespace RhAL
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include "types.h"
+#include "Bindings/SharedMemory.hpp"
+
+namespace RhAL
+{
+class SharedMemoryClient;
+
+/**
+ * SharedTypedRegister
+ *
+ * Client side handle on one Register
+ * exposed by a SharedMemoryServer.
+ * Same read/write API as TypedRegister.
+ * Valid as long as its client is alive.
+ * Thread safe.
+ */
+template <typename T>
+class SharedTypedRegister
+{
+public:
+  /**
+   * Return the last value read
+   * by the server Manager with its
+   * timestamp and error flag
+   * (wait free if no concurrent publication)
+   */
+  ReadValue<T> readValue() const;
+
+  /**
+   * Request the server to write
+   * given value at next Manager flush.
+   * Throw std::runtime_error if the
+   * request ring is full.
+   */
+  void writeValue(T val);
+
+  /**
+   * Request the server to read
+   * the Register at next Manager flush
+   */
+  void askRead();
+
+  /**
+   * Device name, Register name,
+   * Device id and read only flag
+   */
+  std::string deviceName() const;
+  std::string name() const;
+  id_t id() const;
+  bool isReadOnly() const;
+
+private:
+  /**
+   * Created by SharedMemoryClient
+   */
+  SharedTypedRegister(SharedMemoryClient& client, size_t index);
+  friend class SharedMemoryClient;
+
+  /**
+   * Attached client and slot index
+   */
+  SharedMemoryClient* _client;
+  size_t _index;
+};
+
+/**
+ * Typedef for SharedTypedRegister
+ */
+typedef SharedTypedRegister<bool> SharedTypedRegisterBool;
+typedef SharedTypedRegister<int> SharedTypedRegisterInt;
+typedef SharedTypedRegister<float> SharedTypedRegisterFloat;
+
+/**
+ * SharedMemoryClient
+ *
+ * Attach to the shared memory region of
+ * a SharedMemoryServer running in another
+ * process and give access to its Registers
+ * without any system call or socket round trip.
+ * Only depends on the shared memory layout.
+ */
+class SharedMemoryClient
+{
+public:
+  /**
+   * Attach to the region with given name.
+   * Throw std::runtime_error if the region does
+   * not exist or is not a valid RhAL region.
+   */
+  SharedMemoryClient(const std::string& name = "/rhal");
+
+  /**
+   * Detach from the region
+   */
+  ~SharedMemoryClient();
+
+  /**
+   * Copy constructor and
+   * assignement are forbidden
+   */
+  SharedMemoryClient(const SharedMemoryClient&) = delete;
+  SharedMemoryClient& operator=(const SharedMemoryClient&) = delete;
+
+  /**
+   * Return a handle on the Register
+   * with given Device name and Register name.
+   * Throw std::logic_error if not found
+   * or type mismatch.
+   */
+  SharedTypedRegisterBool regBool(const std::string& devName, const std::string& regName);
+  SharedTypedRegisterInt regInt(const std::string& devName, const std::string& regName);
+  SharedTypedRegisterFloat regFloat(const std::string& devName, const std::string& regName);
+
+  /**
+   * Return the number of exposed Registers
+   */
+  size_t count() const;
+
+  /**
+   * Return the server publication epoch
+   * (incremented at each Manager cycle
+   * with new values)
+   */
+  uint64_t epoch() const;
+
+  /**
+   * Return true if the server is still
+   * attached and has updated the region in
+   * the given last duration (in seconds)
+   */
+  bool isAlive(double timeout = 1.0) const;
+
+private:
+  /**
+   * Mapped region address and size
+   */
+  void* _region;
+  size_t _size;
+
+  /**
+   * Region parts
+   */
+  SharedMemoryHeader* _header;
+  SharedRegisterInfo* _infos;
+  SharedRegisterSlot* _slots;
+  SharedRequestCell* _ring;
+  uint64_t _ringMask;
+
+  /**
+   * Return the slot index of given Register
+   * names and check its type.
+   * Throw std::logic_error if not found
+   * or type mismatch.
+   */
+  size_t find(const std::string& devName, const std::string& regName, uint8_t type) const;
+
+  /**
+   * Read given slot consistent
+   * value, timestamp and error flag
+   */
+  void load(size_t index, double& value, TimePoint& timestamp, bool& isError) const;
+
+  /**
+   * Push a request in the ring.
+   * Return false if the ring is full.
+   */
+  bool push(size_t index, uint32_t kind, double value);
+
+  template <typename T>
+  friend class SharedTypedRegister;
+};
+
+}  // namespace RhAL
@@ -0,0 +1,261 @@
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <new>
+#include <stdexcept>
+#include <unordered_map>
+#include "Bindings/SharedMemoryServer.hpp"
+#include "Manager/BaseManager.hpp"
+#include "Manager/Device.hpp"
+#include "timestamp.h"
+
+namespace RhAL
+{
+/**
+ * Copy given string into fixed length
+ * name buffer (truncated if too long)
+ */
+static void copyName(char* dst, const std::string& src)
+{
+  std::memset(dst, 0, SharedNameLen);
+  std::strncpy(dst, src.c_str(), SharedNameLen - 1);
+}
+
+/**
+ * Return the time point as
+ * nanoseconds since clock epoch
+ */
+static int64_t toNanoseconds(const TimePoint& time)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+SharedMemoryServer::SharedMemoryServer(BaseManager& manager, const std::string& name, size_t ringCapacity)
+  : _manager(manager)
+  , _name(name)
+  , _region(nullptr)
+  , _size(0)
+  , _header(nullptr)
+  , _slots(nullptr)
+  , _ring(nullptr)
+  , _ringMask(0)
+  , _registers()
+  , _types()
+  , _entriesSlot()
+  , _epoch(0)
+{
+  // Collect all exposed Registers
+  // with their name and type
+  std::vector<std::string> devNames;
+  for (const auto& it : _manager.devContainer())
+  {
+    const RegistersList& list = it.second->registersList();
+    for (const auto& itReg : list.containerBool())
+    {
+      _registers.push_back(itReg.second);
+      _types.push_back(SharedTypeBool);
+      devNames.push_back(it.first);
+    }
+    for (const auto& itReg : list.containerInt())
+    {
+      _registers.push_back(itReg.second);
+      _types.push_back(SharedTypeInt);
+      devNames.push_back(it.first);
+    }
+    for (const auto& itReg : list.containerFloat())
+    {
+      _registers.push_back(itReg.second);
+      _types.push_back(SharedTypeFloat);
+      devNames.push_back(it.first);
+    }
+  }
+  size_t capacity = 2;
+  while (capacity < ringCapacity)
+  {
+    capacity *= 2;
+  }
+  _ringMask = capacity - 1;
+  _size = sharedMemorySize(_registers.size(), capacity);
+
+  // Create and map the region
+  int fd = shm_open(_name.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0666);
+  if (fd == -1)
+  {
+    throw std::runtime_error("SharedMemoryServer unable to create region: " + _name + ": " + std::strerror(errno));
+  }
+  if (ftruncate(fd, _size) == -1)
+  {
+    close(fd);
+    shm_unlink(_name.c_str());
+    throw std::runtime_error("SharedMemoryServer unable to size region: " + _name + ": " + std::strerror(errno));
+  }
+  _region = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (_region == MAP_FAILED)
+  {
+    shm_unlink(_name.c_str());
+    throw std::runtime_error("SharedMemoryServer unable to map region: " + _name + ": " + std::strerror(errno));
+  }
+
+  // Initialize the layout. The magic
+  // is written last so that clients
+  // only attach to a complete region.
+  _header = new (_region) SharedMemoryHeader();
+  _header->version = SharedMemoryVersion;
+  _header->registerCount = _registers.size();
+  _header->ringCapacity = capacity;
+  _header->epoch = 0;
+  _header->enqueuePos = 0;
+  _header->dequeuePos = 0;
+  _header->heartbeat = toNanoseconds(getTimePoint());
+  SharedRegisterInfo* infos = sharedInfos(_region);
+  _slots = sharedSlots(_region, _registers.size());
+  _ring = sharedRing(_region, _registers.size());
+  for (size_t i = 0; i < _registers.size(); i++)
+  {
+    infos[i].id = _registers[i]->id;
+    infos[i].type = _types[i];
+    infos[i].isReadOnly = _registers[i]->isReadOnly;
+    copyName(infos[i].device, devNames[i]);
+    copyName(infos[i].name, _registers[i]->name);
+    SharedRegisterSlot* slot = new (&_slots[i]) SharedRegisterSlot();
+    slot->sequence = 0;
+    slot->isError = 0;
+    slot->value = sharedToBits(0.0);
+    slot->timestamp = 0;
+  }
+  for (size_t i = 0; i < capacity; i++)
+  {
+    SharedRequestCell* cell = new (&_ring[i]) SharedRequestCell();
+    cell->sequence = i;
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(_header->magic, SharedMemoryMagic, sizeof(SharedMemoryMagic));
+
+  // Publish current values
+  update();
+}
+
+SharedMemoryServer::~SharedMemoryServer()
+{
+  // Invalidate the region for
+  // still attached clients
+  std::memset(_header->magic, 0, sizeof(_header->magic));
+  munmap(_region, _size);
+  shm_unlink(_name.c_str());
+}
+
+void SharedMemoryServer::update()
+{
+  _header->heartbeat.store(toNanoseconds(getTimePoint()), std::memory_order_relaxed);
+  std::shared_ptr<const Snapshot> snapshot = _manager.snapshot();
+  if (snapshot->epoch != _epoch || _epoch == 0)
+  {
+    // Map snapshot entries to slots (the
+    // entries order only changes when
+    // Devices are added)
+    if (_entriesSlot.size() != snapshot->entries.size())
+    {
+      std::unordered_map<const Register*, int> indexes;
+      for (size_t i = 0; i < _registers.size(); i++)
+      {
+        indexes[_registers[i]] = i;
+      }
+      _entriesSlot.assign(snapshot->entries.size(), -1);
+      for (size_t i = 0; i < snapshot->entries.size(); i++)
+      {
+        auto it = indexes.find(snapshot->entries[i].reg);
+        if (it != indexes.end())
+        {
+          _entriesSlot[i] = it->second;
+        }
+      }
+    }
+    for (size_t i = 0; i < snapshot->entries.size(); i++)
+    {
+      if (_entriesSlot[i] >= 0)
+      {
+        const SnapshotEntry& entry = snapshot->entries[i];
+        publish(_entriesSlot[i], entry.value, entry.timestamp, entry.isError);
+      }
+    }
+    _epoch = snapshot->epoch;
+    _header->epoch.fetch_add(1, std::memory_order_release);
+  }
+  processRequests();
+}
+
+size_t SharedMemoryServer::count() const
+{
+  return _registers.size();
+}
+
+void SharedMemoryServer::publish(size_t index, double value, const TimePoint& timestamp, bool isError)
+{
+  SharedRegisterSlot& slot = _slots[index];
+  uint64_t bits = sharedToBits(value);
+  int64_t time = toNanoseconds(timestamp);
+  if (slot.value.load(std::memory_order_relaxed) == bits && slot.timestamp.load(std::memory_order_relaxed) == time &&
+      slot.isError.load(std::memory_order_relaxed) == (uint32_t)isError)
+  {
+    return;
+  }
+  // Sequence lock single writer update
+  uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+  slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.value.store(bits, std::memory_order_relaxed);
+  slot.timestamp.store(time, std::memory_order_relaxed);
+  slot.isError.store(isError, std::memory_order_relaxed);
+  slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void SharedMemoryServer::processRequests()
+{
+  uint64_t pos = _header->dequeuePos.load(std::memory_order_relaxed);
+  while (true)
+  {
+    SharedRequestCell& cell = _ring[pos & _ringMask];
+    if (cell.sequence.load(std::memory_order_acquire) != pos + 1)
+    {
+      // Empty ring
+      break;
+    }
+    uint32_t index = cell.slot;
+    uint32_t kind = cell.kind;
+    double value = cell.value;
+    // Release the cell
+    cell.sequence.store(pos + _ringMask + 1, std::memory_order_release);
+    pos++;
+    _header->dequeuePos.store(pos, std::memory_order_relaxed);
+    // Ignore invalid requests
+    if (index >= _registers.size())
+    {
+      continue;
+    }
+    Register* reg = _registers[index];
+    if (kind == SharedRequestRead)
+    {
+      reg->askRead();
+    }
+    else if (kind == SharedRequestWrite && !reg->isReadOnly)
+    {
+      if (_types[index] == SharedTypeBool)
+      {
+        static_cast<TypedRegisterBool*>(reg)->writeValue(value != 0.0);
+      }
+      else if (_types[index] == SharedTypeInt)
+      {
+        static_cast<TypedRegisterInt*>(reg)->writeValue(value);
+      }
+      else
+      {
+        static_cast<TypedRegisterFloat*>(reg)->writeValue(value);
+      }
+    }
+  }
+}
+
+}  // namespace RhAL
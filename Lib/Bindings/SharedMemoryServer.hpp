@@ -0,0 +1,112 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "types.h"
+#include "Bindings/SharedMemory.hpp"
+
+namespace RhAL
+{
+class BaseManager;
+class Register;
+
+/**
+ * SharedMemoryServer
+ *
+ * Expose all Manager Devices Registers
+ * through a named POSIX shared memory region
+ * so that several processes share one Manager
+ * (see SharedMemoryClient).
+ * Registers values, timestamps and error flags
+ * are published in per Register sequence locked
+ * slots. Client writes and read requests are
+ * received through a lock free multiple producers
+ * ring and applied on the Manager Registers.
+ * Exposed Registers are the ones of the Devices
+ * known at construction.
+ */
+class SharedMemoryServer
+{
+public:
+  /**
+   * Create (or replace) the shared memory
+   * region with given name ("/name") and write
+   * ring capacity (rounded up to a power of 2).
+   * Throw std::runtime_error on system error.
+   */
+  SharedMemoryServer(BaseManager& manager, const std::string& name = "/rhal", size_t ringCapacity = 4096);
+
+  /**
+   * Unmap and remove the region
+   */
+  ~SharedMemoryServer();
+
+  /**
+   * Copy constructor and
+   * assignement are forbidden
+   */
+  SharedMemoryServer(const SharedMemoryServer&) = delete;
+  SharedMemoryServer& operator=(const SharedMemoryServer&) = delete;
+
+  /**
+   * Publish the last Manager snapshot (if
+   * changed) and apply all pending client
+   * requests. Expected to be called at each
+   * Manager cycle by a single thread.
+   */
+  void update();
+
+  /**
+   * Return the number of exposed Registers
+   */
+  size_t count() const;
+
+private:
+  /**
+   * Used Manager instance
+   */
+  BaseManager& _manager;
+
+  /**
+   * Region name, mapped address and size
+   */
+  std::string _name;
+  void* _region;
+  size_t _size;
+
+  /**
+   * Region parts
+   */
+  SharedMemoryHeader* _header;
+  SharedRegisterSlot* _slots;
+  SharedRequestCell* _ring;
+  uint64_t _ringMask;
+
+  /**
+   * Exposed Registers indexed
+   * by slot with their type
+   */
+  std::vector<Register*> _registers;
+  std::vector<uint8_t> _types;
+
+  /**
+   * Slot index of each entry of the
+   * last Manager snapshot (or -1)
+   * and published snapshot epoch
+   */
+  std::vector<int> _entriesSlot;
+  unsigned long _epoch;
+
+  /**
+   * Publish one slot value
+   */
+  void publish(size_t index, double value, const TimePoint& timestamp, bool isError);
+
+  /**
+   * Apply pending client requests
+   */
+  void processRequests();
+};
+
+}  // namespace RhAL
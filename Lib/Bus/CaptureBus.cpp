@@ -0,0 +1,252 @@
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <stdexcept>
+#include "CaptureBus.hpp"
+#include "timestamp.h"
+
+namespace RhAL
+{
+/**
+ * Pcap nanosecond resolution magic
+ * and user defined link type
+ */
+static constexpr uint32_t PcapMagicNano = 0xa1b23c4d;
+static constexpr uint32_t PcapLinkTypeUser0 = 147;
+
+/**
+ * Pcap file and packet headers
+ */
+struct PcapHeader
+{
+  uint32_t magic;
+  uint16_t versionMajor;
+  uint16_t versionMinor;
+  int32_t thisZone;
+  uint32_t sigFigs;
+  uint32_t snapLen;
+  uint32_t linkType;
+};
+struct PcapPacketHeader
+{
+  uint32_t seconds;
+  uint32_t nanoseconds;
+  uint32_t capturedLength;
+  uint32_t length;
+};
+
+/**
+ * Return the smallest power
+ * of 2 greater or equal to given size
+ */
+static size_t roundUpPowerOf2(size_t size)
+{
+  size_t p = 2;
+  while (p < size)
+  {
+    p *= 2;
+  }
+  return p;
+}
+
+CaptureBus::CaptureBus(Bus& bus, size_t capacity)
+  : _bus(bus)
+  , _ring(roundUpPowerOf2(capacity))
+  , _mask(roundUpPowerOf2(capacity) - 1)
+  , _head(0)
+  , _tail(0)
+  , _isCapturing(false)
+  , _isContinue(false)
+  , _dropCount(0)
+  , _origin()
+  , _originTime(0)
+  , _readyTime()
+  , _isReady(false)
+  , _file(nullptr)
+  , _writer()
+{
+}
+
+CaptureBus::~CaptureBus()
+{
+  stop();
+}
+
+void CaptureBus::start(const std::string& path)
+{
+  stop();
+  _file = std::fopen(path.c_str(), "wb");
+  if (_file == nullptr)
+  {
+    throw std::runtime_error("CaptureBus unable to open file: " + path + ": " + std::strerror(errno));
+  }
+  PcapHeader header;
+  header.magic = PcapMagicNano;
+  header.versionMajor = 2;
+  header.versionMinor = 4;
+  header.thisZone = 0;
+  header.sigFigs = 0;
+  header.snapLen = _ring.size();
+  header.linkType = PcapLinkTypeUser0;
+  std::fwrite(&header, sizeof(header), 1, _file);
+  _origin = getTimePoint();
+  _originTime =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+          .count();
+  _head = 0;
+  _tail = 0;
+  _dropCount = 0;
+  _isReady = false;
+  _isContinue = true;
+  _writer = std::thread([this]() {
+    while (_isContinue)
+    {
+      drain();
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+  });
+  _isCapturing.store(true, std::memory_order_release);
+}
+
+void CaptureBus::stop()
+{
+  if (_file == nullptr)
+  {
+    return;
+  }
+  _isCapturing.store(false, std::memory_order_release);
+  _isContinue = false;
+  _writer.join();
+  // Write remaining chunks
+  drain();
+  std::fclose(_file);
+  _file = nullptr;
+}
+
+bool CaptureBus::isCapturing() const
+{
+  return _isCapturing.load(std::memory_order_relaxed);
+}
+
+unsigned long CaptureBus::countDrops() const
+{
+  return _dropCount;
+}
+
+bool CaptureBus::sendData(uint8_t* data, size_t size)
+{
+  if (_isCapturing.load(std::memory_order_relaxed))
+  {
+    push(CaptureTx, data, size, getTimePoint());
+  }
+  return _bus.sendData(data, size);
+}
+
+bool CaptureBus::waitForData(double timeout)
+{
+  bool isAvailable = _bus.waitForData(timeout);
+  if (isAvailable && _isCapturing.load(std::memory_order_relaxed) && !_isReady)
+  {
+    _readyTime = getTimePoint();
+    _isReady = true;
+  }
+  return isAvailable;
+}
+
+size_t CaptureBus::readData(uint8_t* data, size_t size)
+{
+  size_t length = _bus.readData(data, size);
+  if (_isCapturing.load(std::memory_order_relaxed))
+  {
+    push(CaptureRx, data, length, _isReady ? _readyTime : getTimePoint());
+    _isReady = false;
+  }
+  return length;
+}
+
+void CaptureBus::flush()
+{
+  _bus.flush();
+  if (_isCapturing.load(std::memory_order_relaxed))
+  {
+    push(CaptureTxFlushed, nullptr, 0, getTimePoint());
+  }
+}
+
+void CaptureBus::clearInputBuffer()
+{
+  _bus.clearInputBuffer();
+  _isReady = false;
+}
+
+size_t CaptureBus::available()
+{
+  return _bus.available();
+}
+
+void CaptureBus::push(uint8_t kind, const uint8_t* data, size_t size, const TimePoint& time)
+{
+  ChunkHeader header;
+  header.time = std::chrono::duration_cast<std::chrono::nanoseconds>(time - _origin).count();
+  header.length = size;
+  header.kind = kind;
+  uint64_t head = _head.load(std::memory_order_relaxed);
+  uint64_t tail = _tail.load(std::memory_order_acquire);
+  if (head - tail + sizeof(ChunkHeader) + size > _ring.size())
+  {
+    _dropCount++;
+    return;
+  }
+  ringWrite(head, &header, sizeof(ChunkHeader));
+  if (size > 0)
+  {
+    ringWrite(head + sizeof(ChunkHeader), data, size);
+  }
+  _head.store(head + sizeof(ChunkHeader) + size, std::memory_order_release);
+}
+
+void CaptureBus::ringWrite(uint64_t pos, const void* data, size_t size)
+{
+  size_t index = pos & _mask;
+  size_t first = std::min(size, _ring.size() - index);
+  std::memcpy(_ring.data() + index, data, first);
+  std::memcpy(_ring.data(), (const uint8_t*)data + first, size - first);
+}
+
+void CaptureBus::ringRead(uint64_t pos, void* data, size_t size) const
+{
+  size_t index = pos & _mask;
+  size_t first = std::min(size, _ring.size() - index);
+  std::memcpy(data, _ring.data() + index, first);
+  std::memcpy((uint8_t*)data + first, _ring.data(), size - first);
+}
+
+void CaptureBus::drain()
+{
+  uint64_t tail = _tail.load(std::memory_order_relaxed);
+  uint64_t head = _head.load(std::memory_order_acquire);
+  std::vector<uint8_t> buffer;
+  while (tail < head)
+  {
+    ChunkHeader header;
+    ringRead(tail, &header, sizeof(ChunkHeader));
+    buffer.resize(header.length + 1);
+    buffer[0] = header.kind;
+    ringRead(tail + sizeof(ChunkHeader), buffer.data() + 1, header.length);
+    tail += sizeof(ChunkHeader) + header.length;
+    // Release ring space before
+    // the file system call
+    _tail.store(tail, std::memory_order_release);
+    int64_t time = _originTime + header.time;
+    PcapPacketHeader packet;
+    packet.seconds = time / 1000000000;
+    packet.nanoseconds = time % 1000000000;
+    packet.capturedLength = buffer.size();
+    packet.length = buffer.size();
+    std::fwrite(&packet, sizeof(packet), 1, _file);
+    std::fwrite(buffer.data(), buffer.size(), 1, _file);
+  }
+  std::fflush(_file);
+}
+
+}  // namespace RhAL
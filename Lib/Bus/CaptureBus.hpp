@@ -0,0 +1,174 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstdio>
+#include "Bus.hpp"
+#include "types.h"
+
+namespace RhAL
+{
+/**
+ * CaptureBus chunk kinds, stored as
+ * the first byte of each captured packet
+ */
+enum : uint8_t
+{
+  // Bytes sent to the bus
+  CaptureTx = 0,
+  // Output buffer drained on the wire (empty)
+  CaptureTxFlushed = 1,
+  // Bytes received from the bus. Timestamped
+  // when waitForData() reported them available.
+  CaptureRx = 2,
+};
+
+/**
+ * CaptureBus
+ *
+ * Bus decorator forwarding all calls to the
+ * wrapped Bus and, when capture is started,
+ * recording every sent and received bytes
+ * chunk with its timestamp in a pcap file
+ * (nanosecond resolution, LINKTYPE_USER0, one
+ * kind byte before the chunk bytes).
+ * Chunks are pushed in a lock free single producer
+ * ring buffer and written to the file by a
+ * background thread. Calls to the Bus are expected
+ * to be serialized by its user (the Manager
+ * bus mutex).
+ * When capture is not started, the overhead is
+ * one relaxed atomic load per call.
+ */
+class CaptureBus : public Bus
+{
+public:
+  /**
+   * Initialization with the wrapped
+   * Bus (not owned) and ring buffer
+   * capacity in bytes (rounded up to
+   * a power of 2)
+   */
+  CaptureBus(Bus& bus, size_t capacity = 1 << 20);
+
+  /**
+   * Stop the capture
+   */
+  virtual ~CaptureBus();
+
+  /**
+   * Copy constructor and
+   * assignement are forbidden
+   */
+  CaptureBus(const CaptureBus&) = delete;
+  CaptureBus& operator=(const CaptureBus&) = delete;
+
+  /**
+   * Create given pcap file and start
+   * the capture (restarted if running).
+   * Throw std::runtime_error if the file
+   * cannot be created.
+   */
+  void start(const std::string& path);
+
+  /**
+   * Write remaining chunks, close
+   * the file and stop the capture
+   */
+  void stop();
+
+  /**
+   * Return true if the capture is running
+   */
+  bool isCapturing() const;
+
+  /**
+   * Return the number of chunks dropped
+   * because the ring buffer was full
+   */
+  unsigned long countDrops() const;
+
+  /**
+   * Inherit from Bus.
+   * Forward to the wrapped Bus.
+   */
+  virtual bool sendData(uint8_t* data, size_t size) override;
+  virtual bool waitForData(double timeout) override;
+  virtual size_t readData(uint8_t* data, size_t size) override;
+  virtual void flush() override;
+  virtual void clearInputBuffer() override;
+  virtual size_t available() override;
+
+private:
+  /**
+   * Chunk header in the ring buffer
+   */
+  struct ChunkHeader
+  {
+    uint64_t time;
+    uint32_t length;
+    uint8_t kind;
+  };
+
+  /**
+   * Wrapped bus
+   */
+  Bus& _bus;
+
+  /**
+   * Bytes ring buffer, capacity mask and
+   * producer/consumer positions
+   */
+  std::vector<uint8_t> _ring;
+  size_t _mask;
+  std::atomic<uint64_t> _head;
+  std::atomic<uint64_t> _tail;
+
+  /**
+   * Capture state and statistics
+   */
+  std::atomic<bool> _isCapturing;
+  std::atomic<bool> _isContinue;
+  std::atomic<unsigned long> _dropCount;
+
+  /**
+   * Timestamps origin: steady and
+   * system clock at capture start
+   */
+  TimePoint _origin;
+  int64_t _originTime;
+
+  /**
+   * Time at which last waitForData()
+   * reported available bytes
+   */
+  TimePoint _readyTime;
+  bool _isReady;
+
+  /**
+   * Output file and writer thread
+   */
+  FILE* _file;
+  std::thread _writer;
+
+  /**
+   * Push a chunk in the ring buffer
+   * (dropped if full)
+   */
+  void push(uint8_t kind, const uint8_t* data, size_t size, const TimePoint& time);
+
+  /**
+   * Copy from/to the ring with wrap around
+   */
+  void ringWrite(uint64_t pos, const void* data, size_t size);
+  void ringRead(uint64_t pos, void* data, size_t size) const;
+
+  /**
+   * Write all pending chunks to the file
+   */
+  void drain();
+};
+
+}  // namespace RhAL
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <stdexcept>
 #include "SerialBus.hpp"
 
 namespace RhAL
@@ -92,4 +93,17 @@ void SerialBus::clearInputBuffer()
   //        uint8_t dummy[n];
   //        this->readData(dummy, n);
 }
+
+void SerialBus::setBaudrate(unsigned int baudrate)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  try
+  {
+    serial.setBaudrate(baudrate);
+  }
+  catch (const std::exception& e)
+  {
+    throw std::runtime_error("SerialBus::setBaudrate(): " + std::to_string(baudrate) + " " + e.what());
+  }
+}
 }  // namespace RhAL
@@ -19,6 +19,13 @@ public:
   void flush();
   void clearInputBuffer();
 
+  /**
+   * Change the port baudrate without
+   * closing it. Throw std::runtime_error
+   * on failure.
+   */
+  void setBaudrate(unsigned int baudrate);
+
 protected:
   serial::Serial serial;
   std::mutex mutex;
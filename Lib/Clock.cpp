@@ -0,0 +1,140 @@
+#include <thread>
+#include "Clock.hpp"
+#include "timestamp.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define RHAL_HAS_TSC 1
+#endif
+
+namespace RhAL
+{
+Clock::~Clock()
+{
+}
+
+void Clock::sleepFor(const TimeDurationFloat& duration)
+{
+  sleepUntil(now() + std::chrono::duration_cast<TimePoint::duration>(duration));
+}
+
+TimePoint SteadyClock::now()
+{
+  return getTimePoint();
+}
+
+void SteadyClock::sleepUntil(const TimePoint& time)
+{
+  std::this_thread::sleep_until(time);
+}
+
+/**
+ * Read the time stamp counter
+ */
+static inline uint64_t readTicks()
+{
+#ifdef RHAL_HAS_TSC
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+TscClock::TscClock() : _origin(), _originTicks(0), _nsPerTick(0.0)
+{
+#ifdef RHAL_HAS_TSC
+  // Measure the counter frequency
+  TimePoint start = getTimePoint();
+  uint64_t startTicks = readTicks();
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  TimePoint stop = getTimePoint();
+  uint64_t stopTicks = readTicks();
+  // The counter may not be monotonic across
+  // cores, keep the steady clock if the
+  // calibration is not usable
+  int64_t ticks = (int64_t)(stopTicks - startTicks);
+  if (ticks > 0)
+  {
+    _nsPerTick = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count() / (double)ticks;
+  }
+  _origin = stop;
+  _originTicks = stopTicks;
+#endif
+}
+
+TimePoint TscClock::now()
+{
+#ifdef RHAL_HAS_TSC
+  if (_nsPerTick <= 0.0)
+  {
+    return getTimePoint();
+  }
+  // Signed difference clamped at origin
+  // (counter read on a core lagging behind
+  // the calibration one)
+  int64_t ticks = (int64_t)(readTicks() - _originTicks);
+  if (ticks < 0)
+  {
+    ticks = 0;
+  }
+  return _origin + std::chrono::nanoseconds((int64_t)(ticks * _nsPerTick));
+#else
+  return getTimePoint();
+#endif
+}
+
+void TscClock::sleepUntil(const TimePoint& time)
+{
+  std::this_thread::sleep_for(time - now());
+}
+
+VirtualClock::VirtualClock(bool isAutoAdvance)
+  : _time(std::chrono::duration_cast<std::chrono::nanoseconds>(getTimePoint().time_since_epoch()).count())
+  , _isAutoAdvance(isAutoAdvance)
+  , _mutex()
+  , _cond()
+{
+}
+
+void VirtualClock::advance(const TimeDurationFloat& duration)
+{
+  advanceTo(_time + std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
+
+TimePoint VirtualClock::now()
+{
+  return TimePoint(std::chrono::nanoseconds(_time.load()));
+}
+
+void VirtualClock::sleepUntil(const TimePoint& time)
+{
+  int64_t date = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+  if (_isAutoAdvance)
+  {
+    advanceTo(date);
+  }
+  else
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _cond.wait(lock, [this, date]() { return _time >= date; });
+  }
+}
+
+void VirtualClock::advanceTo(int64_t time)
+{
+  int64_t current = _time.load();
+  while (current < time && !_time.compare_exchange_weak(current, time))
+  {
+  }
+  // Lock to not miss a sleeping
+  // thread about to wait
+  std::lock_guard<std::mutex> lock(_mutex);
+  _cond.notify_all();
+}
+
+Clock& defaultClock()
+{
+  static SteadyClock clock;
+  return clock;
+}
+
+}  // namespace RhAL
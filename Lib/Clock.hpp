@@ -0,0 +1,159 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include "types.h"
+
+namespace RhAL
+{
+/**
+ * Clock
+ *
+ * Time source used by the Manager,
+ * Protocols and Devices for timestamps,
+ * durations and waits.
+ */
+class Clock
+{
+public:
+  /**
+   * Virtual destructor
+   */
+  virtual ~Clock();
+
+  /**
+   * Return the current time
+   */
+  virtual TimePoint now() = 0;
+
+  /**
+   * Block the calling thread until
+   * given time is reached
+   */
+  virtual void sleepUntil(const TimePoint& time) = 0;
+
+  /**
+   * Block the calling thread
+   * for given duration
+   */
+  void sleepFor(const TimeDurationFloat& duration);
+};
+
+/**
+ * SteadyClock
+ *
+ * Real time monotonic system clock
+ * (same as getTimePoint()).
+ * Used by default.
+ */
+class SteadyClock : public Clock
+{
+public:
+  /**
+   * Inherit
+   */
+  virtual TimePoint now() override;
+  virtual void sleepUntil(const TimePoint& time) override;
+};
+
+/**
+ * TscClock
+ *
+ * Real time clock reading the processor
+ * time stamp counter, calibrated against the
+ * steady clock at construction (cheaper than
+ * a system call on x86). Fall back to the
+ * steady clock on other architectures or if
+ * the calibration fails.
+ */
+class TscClock : public Clock
+{
+public:
+  /**
+   * Initialization and calibration
+   * (blocks for a few milliseconds)
+   */
+  TscClock();
+
+  /**
+   * Inherit
+   */
+  virtual TimePoint now() override;
+  virtual void sleepUntil(const TimePoint& time) override;
+
+private:
+  /**
+   * Calibration origin and
+   * nanoseconds per counter tick
+   */
+  TimePoint _origin;
+  uint64_t _originTicks;
+  double _nsPerTick;
+};
+
+/**
+ * VirtualClock
+ *
+ * Simulated time only moving forward by
+ * advance() calls or by sleeps.
+ * If isAutoAdvance is true, sleeping immediately
+ * advances the time to the wake up date (faster
+ * than real time simulation). Else, sleeping
+ * threads are blocked until a simulator advances
+ * the time past their wake up date.
+ * Thread safe.
+ */
+class VirtualClock : public Clock
+{
+public:
+  /**
+   * Initialization with auto advance mode.
+   * Time starts at current real time.
+   */
+  VirtualClock(bool isAutoAdvance = true);
+
+  /**
+   * Move the time forward by given
+   * duration and wake up sleeping threads
+   */
+  void advance(const TimeDurationFloat& duration);
+
+  /**
+   * Inherit
+   */
+  virtual TimePoint now() override;
+  virtual void sleepUntil(const TimePoint& time) override;
+
+private:
+  /**
+   * Current time in nanoseconds
+   * since steady clock epoch
+   */
+  std::atomic<int64_t> _time;
+
+  /**
+   * Sleeps advance the time
+   */
+  const bool _isAutoAdvance;
+
+  /**
+   * Sleeping threads wake up
+   */
+  std::mutex _mutex;
+  std::condition_variable _cond;
+
+  /**
+   * Move the time forward to given
+   * date if it is in the future
+   */
+  void advanceTo(int64_t time);
+};
+
+/**
+ * Return the process wide
+ * default SteadyClock instance
+ */
+Clock& defaultClock();
+
+}  // namespace RhAL
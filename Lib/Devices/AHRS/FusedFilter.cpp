@@ -0,0 +1,164 @@
+/* DCM algorithm from the Razor AHRS Firmware */
+#include <cmath>
+#include <algorithm>
+#include "FusedFilter.hpp"
+
+#define GRAVITY 256.0
+#define Kp_YAW 1.2
+#define Ki_YAW 0.00002
+// XXX: Be more accurate?
+#define G_Dt 0.01
+
+namespace AHRS
+{
+/**
+ * Wrap given angle in [-pi:pi]
+ */
+static double wrapAngle(double angle)
+{
+  while (angle > M_PI)
+    angle -= 2 * M_PI;
+  while (angle < -M_PI)
+    angle += 2 * M_PI;
+  return angle;
+}
+
+FusedFilter::FusedFilter()
+  : yaw(0)
+  , yawCompass(0)
+  , pitch(0)
+  , roll(0)
+  , gyroYaw(0)
+  , magnAzimuth(0)
+  , magnHeading(0)
+  , Kp_rollPitch(0.02)
+  , Ki_rollPitch(0.00002)
+  , invertX(false)
+  , invertY(false)
+  , invertZ(false)
+  , tick(0)
+  , _dcm(Eigen::Matrix3d::Identity())
+  , _omegaP(Eigen::Vector3d::Zero())
+  , _omegaI(Eigen::Vector3d::Zero())
+  , _yawOffset(0)
+  , _yawOffsetP(0)
+  , _yawOffsetI(0)
+{
+}
+
+void FusedFilter::update(const Sample& sample)
+{
+  update(&sample, 1);
+}
+
+void FusedFilter::update(const Sample* samples, size_t count)
+{
+  if (count == 0)
+  {
+    return;
+  }
+  Eigen::Array3d signs = inversionSigns();
+  for (size_t i = 0; i < count; i++)
+  {
+    integrate(samples[i], signs);
+  }
+  // Yaw is only needed once per burst
+  yaw = atan2(_dcm(1, 0) * signs(0), _dcm(0, 0) * signs(0));
+  yawCompass = wrapAngle(yaw + _yawOffset);
+}
+
+Eigen::Matrix3d FusedFilter::getMatrix() const
+{
+  return _dcm * inversionSigns().matrix().asDiagonal();
+}
+
+Eigen::Matrix3d FusedFilter::getMatrixCompass() const
+{
+  return Eigen::AngleAxisd(_yawOffset, Eigen::Vector3d::UnitZ()) * getMatrix();
+}
+
+Eigen::Array3d FusedFilter::inversionSigns() const
+{
+  // Product of the diagonal
+  // inversion matrices
+  Eigen::Array3d signs(1, 1, 1);
+  if (invertX)
+  {
+    signs *= Eigen::Array3d(1, -1, -1);
+  }
+  if (invertY)
+  {
+    signs *= Eigen::Array3d(-1, 1, -1);
+  }
+  if (invertZ)
+  {
+    signs *= Eigen::Array3d(-1, -1, 1);
+  }
+  return signs;
+}
+
+void FusedFilter::integrate(const Sample& sample, const Eigen::Array3d& signs)
+{
+  // Updating gyro Yaw
+  double sign = (invertX || invertY) ? -1 : 1;
+  gyroYaw = wrapAngle(gyroYaw + sign * sample.gyro(2) * G_Dt);
+
+  // Updating magn azimuth
+  magnAzimuth = atan2(sample.magnetom(2), sample.magnetom(0));
+
+  // Tilt compensated magnetic heading
+  // (from previous roll and pitch)
+  double cosRoll = cos(roll);
+  double sinRoll = sin(roll);
+  double cosPitch = cos(pitch);
+  double sinPitch = sin(pitch);
+  double magX = sample.magnetom(0) * cosPitch + sample.magnetom(1) * sinRoll * sinPitch +
+                sample.magnetom(2) * cosRoll * sinPitch;
+  double magY = sample.magnetom(1) * cosRoll - sample.magnetom(2) * sinRoll;
+  magnHeading = atan2(-magY, magX);
+
+  // Matrix update with drift corrected rates
+  Eigen::Vector3d omega = (sample.gyro + _omegaI + _omegaP) * G_Dt;
+  Eigen::Matrix3d update;
+  update << 0, -omega(2), omega(1), omega(2), 0, -omega(0), -omega(1), omega(0), 0;
+  _dcm += _dcm * update;
+  _yawOffset = wrapAngle(_yawOffset + (_yawOffsetP + _yawOffsetI) * G_Dt);
+
+  // Normalize (eq.19 to eq.21)
+  double error = -0.5 * _dcm.row(0).dot(_dcm.row(1));
+  Eigen::Vector3d x = _dcm.row(0).transpose() + error * _dcm.row(1).transpose();
+  Eigen::Vector3d y = _dcm.row(1).transpose() + error * _dcm.row(0).transpose();
+  Eigen::Vector3d z = x.cross(y);
+  _dcm.row(0) = 0.5 * (3 - x.squaredNorm()) * x.transpose();
+  _dcm.row(1) = 0.5 * (3 - y.squaredNorm()) * y.transpose();
+  _dcm.row(2) = 0.5 * (3 - z.squaredNorm()) * z.transpose();
+
+  // Roll and pitch drift correction with
+  // dynamic weighting of accelerometer info
+  // (<0.5G = 0.0, 1G = 1.0 , >1.5G = 0.0)
+  tick++;
+  Eigen::Vector3d accel = sample.accel * GRAVITY;
+  double weight = 1 - 2 * fabs(1 - accel.norm() / GRAVITY);
+  weight = std::min(std::max(weight, 0.0), 1.0);
+  Eigen::Vector3d errorRollPitch = accel.cross(_dcm.row(2).transpose());
+  // Initializing the filter during the 10 first ticks
+  double K = (tick < 10) ? 0.5 : Kp_rollPitch;
+  _omegaP = errorRollPitch * K * weight;
+  _omegaI += errorRollPitch * Ki_rollPitch * weight;
+
+  // Compass yaw drift correction
+  // on the offset DCM first column
+  double cosOffset = cos(_yawOffset);
+  double sinOffset = sin(_yawOffset);
+  double m00 = cosOffset * _dcm(0, 0) - sinOffset * _dcm(1, 0);
+  double m10 = sinOffset * _dcm(0, 0) + cosOffset * _dcm(1, 0);
+  double errorCourse = m00 * sin(magnHeading) - m10 * cos(magnHeading);
+  _yawOffsetP = errorCourse * Kp_YAW;
+  _yawOffsetI += errorCourse * Ki_YAW;
+
+  // Shared roll and pitch
+  pitch = -asin(_dcm(2, 0) * signs(0));
+  roll = atan2(_dcm(2, 1) * signs(1), _dcm(2, 2) * signs(2));
+}
+
+}  // namespace AHRS
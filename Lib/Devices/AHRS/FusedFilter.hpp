@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <Eigen/Dense>
+
+namespace AHRS
+{
+/**
+ * One calibrated IMU sample
+ * (accelerometer in g, gyroscope in rad/s
+ * and normalized magnetometer)
+ */
+struct Sample
+{
+  Eigen::Vector3d accel;
+  Eigen::Vector3d gyro;
+  Eigen::Vector3d magnetom;
+};
+
+/**
+ * FusedFilter
+ *
+ * DCM filter (same algorithm and gains as Filter)
+ * computing both the non compass and the compass
+ * outputs from a single integration.
+ * The compass yaw drift correction is a rotation
+ * around the world vertical axis which leaves roll
+ * and pitch unchanged. It is thus applied as a yaw
+ * offset (with the same proportional and integral
+ * gains) on top of the shared non compass DCM instead
+ * of integrating a second matrix.
+ */
+class FusedFilter
+{
+public:
+  /**
+   * Initialization
+   */
+  FusedFilter();
+
+  /**
+   * Update the filter with one sample
+   * or with a burst of given count samples
+   * (in chronological order)
+   */
+  void update(const Sample& sample);
+  void update(const Sample* samples, size_t count);
+
+  /**
+   * Get DCM matrix without and
+   * with compass yaw correction
+   */
+  Eigen::Matrix3d getMatrix() const;
+  Eigen::Matrix3d getMatrixCompass() const;
+
+  // Euler angles (roll and pitch
+  // are shared by both outputs)
+  double yaw;
+  double yawCompass;
+  double pitch;
+  double roll;
+  double gyroYaw;
+
+  // Magnetometer
+  double magnAzimuth;
+  double magnHeading;
+
+  // Kp & Ki for filter
+  double Kp_rollPitch;
+  double Ki_rollPitch;
+
+  // Invert? (X Axis backward)
+  bool invertX, invertY, invertZ;
+
+  // Tick number
+  int tick;
+
+protected:
+  // Shared DCM and roll pitch
+  // drift correction integrator
+  Eigen::Matrix3d _dcm;
+  Eigen::Vector3d _omegaP;
+  Eigen::Vector3d _omegaI;
+
+  // Compass yaw offset around the
+  // world vertical axis and its drift
+  // correction (proportional and integral)
+  double _yawOffset;
+  double _yawOffsetP;
+  double _yawOffsetI;
+
+  /**
+   * Return the column signs
+   * applied by the inversions
+   */
+  Eigen::Array3d inversionSigns() const;
+
+  /**
+   * Integrate one sample
+   */
+  void integrate(const Sample& sample, const Eigen::Array3d& signs);
+};
+}  // namespace AHRS
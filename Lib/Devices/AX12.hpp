@@ -32,7 +32,7 @@ template <>
 class ImplManager<AX12> : public TypedManager<AX12>
 {
 public:
-  inline static type_t typeNumber()
+  inline static constexpr type_t typeNumber()
   {
     return 0x000C;
   }
@@ -32,7 +32,7 @@ template <>
 class ImplManager<AX18> : public TypedManager<AX18>
 {
 public:
-  inline static type_t typeNumber()
+  inline static constexpr type_t typeNumber()
   {
     return 0x0012;
   }
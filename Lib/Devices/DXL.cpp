@@ -104,7 +104,7 @@ DXL::DXL(const std::string& name, id_t id)
   , _angleLimitCCWParameter("angleLimitCCWParameter", 0.0)
   , _inverted("inverse", false)
   , _zero("zero", 0.0)
-  , _isSmoothingActive(false)
+  , _calibration(Calibration{ 0.0, false })
 {
   _temperatureLimit.setMinValue(0);
   _temperatureLimit.setMaxValue(255);  // uint8 but you should not go to 255°!!
@@ -123,6 +123,32 @@ DXL::DXL(const std::string& name, id_t id)
   _maxTorque.setStepValue(0.000977517);  // 1.0/1023
 }
 
+void DXL::getLinkConfig(std::vector<ConfigValue>& config, bool isOptimized, bool isWriteStatus)
+{
+  // Status return level 1: read only,
+  // 2: all instructions (default)
+  if (isOptimized)
+  {
+    config.push_back(ConfigValue(_returnDelayTime, 0));
+    config.push_back(ConfigValue(_statusReturnLevel, isWriteStatus ? 2 : 1));
+  }
+  else
+  {
+    config.push_back(ConfigValue(_statusReturnLevel, 2));
+  }
+}
+
+bool DXL::baudrateCode(unsigned long baudrate, addr_t& addr, data_t& code) const
+{
+  if (baudrate == 0 || baudrate > 1000000 || 2000000 % baudrate != 0 || 2000000 / baudrate > 255)
+  {
+    return false;
+  }
+  addr = _baudrate.addr;
+  code = 2000000 / baudrate - 1;
+  return true;
+}
+
 TypedRegisterInt& DXL::firmwareVersion()
 {
   return _firmwareVersion;
@@ -169,18 +195,13 @@ void DXL::disableTorque()
   torqueEnable().writeValue(false);
 }
 
-void DXL::setGoalPositionSmooth(float angle, float delay)
+void DXL::setGoalPositionSmooth(float angle, float delay, InterpolationProfile profile)
 {
-  _isSmoothingActive = true;
-  _smoothingStartGoal = position().readValue().value;
-  _smoothingEndGoal = angle;
-  _smoothingCurrentTime = 0.0;
-  _smoothingEndTime = delay;
-  goalPosition().writeValue(_smoothingStartGoal);
+  interpolator().start(goalPosition(), position().readValue().value, angle, delay, clock().now(), profile);
 }
 bool DXL::isSmoothingActive() const
 {
-  return _isSmoothingActive;
+  return interpolator().isActive(const_cast<DXL*>(this)->goalPosition());
 }
 
 bool DXL::getInverted()
@@ -192,6 +213,7 @@ void DXL::setInverted(bool value)
 {
   std::lock_guard<std::mutex> lock(_mutex);
   _inverted.value = value;
+  _calibration.store(Calibration{ (float)_zero.value, _inverted.value });
 }
 float DXL::getZero()
 {
@@ -202,33 +224,20 @@ void DXL::setZero(float value)
 {
   std::lock_guard<std::mutex> lock(_mutex);
   _zero.value = value;
+  _calibration.store(Calibration{ (float)_zero.value, _inverted.value });
+}
+
+void DXL::onParametersUpdate()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _calibration.store(Calibration{ (float)_zero.value, _inverted.value });
 }
 
 void DXL::onSwap()
 {
-  TimePoint tp = getTimePoint();
+  TimePoint tp = clock().now();
   t = duration_float(tp);
-  float step = duration_float(_lastTp, tp);
-  if (_lastTp == TimePoint())
-  {
-    _lastTp = tp;
-    return;
-  }
   _lastTp = tp;
-
-  if (_isSmoothingActive)
-  {
-    if (_smoothingEndTime == 0.0)  // FIXME: is it necessary?
-      _smoothingEndTime = 0.001;
-    double goal =
-        ((_smoothingEndGoal - _smoothingStartGoal) / _smoothingEndTime) * _smoothingCurrentTime + _smoothingStartGoal;
-    goalPosition().writeValue(goal);
-    _smoothingCurrentTime += step;
-    if (_smoothingCurrentTime >= _smoothingEndTime)
-    {
-      _isSmoothingActive = false;
-    }
-  }
 }
 
 void DXL::onInit()
@@ -7,7 +7,9 @@
 #include "Manager/TypedManager.hpp"
 #include "Manager/Device.hpp"
 #include "Manager/Register.hpp"
+#include "Manager/RegisterDescriptor.hpp"
 #include "Manager/Parameter.hpp"
+#include "Manager/Interpolator.hpp"
 
 namespace RhAL
 {
@@ -217,9 +219,11 @@ public:
 
   /**
    * Go to given goal position (degree or radian) smoothed
-   * with given delay in seconds.
+   * with given delay in seconds and given profile.
+   * The goal is updated at each flush by the
+   * Manager interpolation engine.
    */
-  void setGoalPositionSmooth(float angle, float delay);
+  void setGoalPositionSmooth(float angle, float delay, InterpolationProfile profile = InterpolationLinear);
   /**
    * Return true if smoothing if currently enabled or
    * is finished
@@ -250,6 +254,27 @@ public:
    */
   void setZero(float value);
 
+  /**
+   * Inherit.
+   * Publish zero and inversion parameters
+   * to the calibration snapshot.
+   */
+  virtual void onParametersUpdate() override;
+
+  /**
+   * Inherit.
+   * Null return delay and status packets
+   * only for read if no write status.
+   */
+  virtual void getLinkConfig(std::vector<ConfigValue>& config, bool isOptimized, bool isWriteStatus) override;
+
+  /**
+   * Inherit.
+   * Baudrates of the form 2M/(code+1)
+   * up to 1M are supported.
+   */
+  virtual bool baudrateCode(unsigned long baudrate, addr_t& addr, data_t& code) const override;
+
 protected:
   /**
    * Registers
@@ -276,24 +301,21 @@ protected:
   ParameterNumber _zero;
 
   /**
-   * Time measure
+   * Lock free snapshot of zero and inverted
+   * parameters read by calibrated registers
+   * conversions
    */
-  TimePoint _lastTp;
-  double t;
+  AtomicCalibration _calibration;
 
   /**
-   * Goal position smoothing state
+   * Time measure
    */
-  bool _isSmoothingActive;
-  double _smoothingStartGoal;
-  double _smoothingEndGoal;
-  double _smoothingCurrentTime;
-  double _smoothingEndTime;
+  TimePoint _lastTp;
+  double t;
 
   /**
    * Inherit.
    * Flush() callback.
-   * Implement position smoothing.
    */
   virtual void onSwap() override;
 
@@ -1,9 +1,5 @@
 #include "Devices/Dynaban64.hpp"
 
-// All the positions have an offset of 180 degrees (also true for the MXs and the RXs). This is because dxl's zeros are
-// not the same among different servomotors, so we unified them.
-#define OFFSET 180
-
 namespace RhAL
 {
 void convEncode_PolyDuration(data_t* buffer, float value)
@@ -86,412 +82,30 @@ Dynaban64::Dynaban64(const std::string& name, id_t id)
   //_register("name", address, size, encodeFunction, decodeFunction, updateFreq, forceRead=true, forceWrite=false,
   // isSlow=false)
   _trajPoly1Size("trajPoly1Size", 0x4A, 1, convEncode_1Byte, convDecode_1Byte, 0)
-  , _traj1a0("traj1a0", 0x4B, 4,
-             [this](data_t* data, float value) {
-               std::lock_guard<std::mutex> lock(this->_mutex);
-               int direction = 1;
-               if (this->_inverted.value == true)
-               {
-                 direction = -1;
-               }
-               convEncode_positionTraj(data, (value + this->_zero.value + OFFSET) * direction);
-             },
-             [this](const data_t* data) -> float {
-               std::lock_guard<std::mutex> lock(_mutex);
-               float value = convDecode_positionTraj(data);
-               if (this->_inverted.value == true)
-               {
-                 value = value * -1.0;
-               }
-               value = value - (this->_zero.value - OFFSET);
-               return value;
-             },
-             0)
-  , _traj1a1("traj1a1", 0x4F, 4,
-             [this](data_t* data, float value) {
-               std::lock_guard<std::mutex> lock(this->_mutex);
-               int direction = 1;
-               if (this->_inverted.value == true)
-               {
-                 direction = -1;
-               }
-               convEncode_positionTraj(data, value * direction);
-             },
-             [this](const data_t* data) -> float {
-               std::lock_guard<std::mutex> lock(_mutex);
-               float value = convDecode_positionTraj(data);
-               if (this->_inverted.value == true)
-               {
-                 value = value * -1.0;
-               }
-               return value;
-             },
-             0)
-  , _traj1a2("traj1a2", 0x53, 4,
-             [this](data_t* data, float value) {
-               std::lock_guard<std::mutex> lock(this->_mutex);
-               int direction = 1;
-               if (this->_inverted.value == true)
-               {
-                 direction = -1;
-               }
-               convEncode_positionTraj(data, value * direction);
-             },
-             [this](const data_t* data) -> float {
-               std::lock_guard<std::mutex> lock(_mutex);
-               float value = convDecode_positionTraj(data);
-               if (this->_inverted.value == true)
-               {
-                 value = value * -1.0;
-               }
-               return value;
-             },
-             0)
-  , _traj1a3("traj1a3", 0x57, 4,
-             [this](data_t* data, float value) {
-               std::lock_guard<std::mutex> lock(this->_mutex);
-               int direction = 1;
-               if (this->_inverted.value == true)
-               {
-                 direction = -1;
-               }
-               convEncode_positionTraj(data, value * direction);
-             },
-             [this](const data_t* data) -> float {
-               std::lock_guard<std::mutex> lock(_mutex);
-               float value = convDecode_positionTraj(data);
-               if (this->_inverted.value == true)
-               {
-                 value = value * -1.0;
-               }
-               return value;
-             },
-             0)
-  , _traj1a4("traj1a4", 0x5B, 4,
-             [this](data_t* data, float value) {
-               std::lock_guard<std::mutex> lock(this->_mutex);
-               int direction = 1;
-               if (this->_inverted.value == true)
-               {
-                 direction = -1;
-               }
-               convEncode_positionTraj(data, value * direction);
-             },
-             [this](const data_t* data) -> float {
-               std::lock_guard<std::mutex> lock(_mutex);
-               float value = convDecode_positionTraj(data);
-               if (this->_inverted.value == true)
-               {
-                 value = value * -1.0;
-               }
-               return value;
-             },
-             0)
+  , _traj1a0("traj1a0", _calibration, 0)
+  , _traj1a1("traj1a1", _calibration, 0)
+  , _traj1a2("traj1a2", _calibration, 0)
+  , _traj1a3("traj1a3", _calibration, 0)
+  , _traj1a4("traj1a4", _calibration, 0)
   , _torquePoly1Size("torquePoly1Size", 0x5F, 1, convEncode_1Byte, convDecode_1Byte, 0)
-  , _torque1a0("torque1a0", 0x60, 4,
-               [this](data_t* data, float value) {
-                 std::lock_guard<std::mutex> lock(this->_mutex);
-                 int direction = 1;
-                 if (this->_inverted.value == true)
-                 {
-                   direction = -1;
-                 }
-                 convEncode_positionTraj(data, value * direction);
-               },
-               [this](const data_t* data) -> float {
-                 std::lock_guard<std::mutex> lock(_mutex);
-                 float value = convDecode_positionTraj(data);
-                 if (this->_inverted.value == true)
-                 {
-                   value = value * -1.0;
-                 }
-                 return value;
-               },
-               0)
-  , _torque1a1("torque1a1", 0x64, 4,
-               [this](data_t* data, float value) {
-                 std::lock_guard<std::mutex> lock(this->_mutex);
-                 int direction = 1;
-                 if (this->_inverted.value == true)
-                 {
-                   direction = -1;
-                 }
-                 convEncode_positionTraj(data, value * direction);
-               },
-               [this](const data_t* data) -> float {
-                 std::lock_guard<std::mutex> lock(_mutex);
-                 float value = convDecode_positionTraj(data);
-                 if (this->_inverted.value == true)
-                 {
-                   value = value * -1.0;
-                 }
-                 return value;
-               },
-               0)
-  , _torque1a2("torque1a2", 0x68, 4,
-               [this](data_t* data, float value) {
-                 std::lock_guard<std::mutex> lock(this->_mutex);
-                 int direction = 1;
-                 if (this->_inverted.value == true)
-                 {
-                   direction = -1;
-                 }
-                 convEncode_positionTraj(data, value * direction);
-               },
-               [this](const data_t* data) -> float {
-                 std::lock_guard<std::mutex> lock(_mutex);
-                 float value = convDecode_positionTraj(data);
-                 if (this->_inverted.value == true)
-                 {
-                   value = value * -1.0;
-                 }
-                 return value;
-               },
-               0)
-  , _torque1a3("torque1a3", 0x6C, 4,
-               [this](data_t* data, float value) {
-                 std::lock_guard<std::mutex> lock(this->_mutex);
-                 int direction = 1;
-                 if (this->_inverted.value == true)
-                 {
-                   direction = -1;
-                 }
-                 convEncode_positionTraj(data, value * direction);
-               },
-               [this](const data_t* data) -> float {
-                 std::lock_guard<std::mutex> lock(_mutex);
-                 float value = convDecode_positionTraj(data);
-                 if (this->_inverted.value == true)
-                 {
-                   value = value * -1.0;
-                 }
-                 return value;
-               },
-               0)
-  , _torque1a4("torque1a4", 0x70, 4,
-               [this](data_t* data, float value) {
-                 std::lock_guard<std::mutex> lock(this->_mutex);
-                 int direction = 1;
-                 if (this->_inverted.value == true)
-                 {
-                   direction = -1;
-                 }
-                 convEncode_positionTraj(data, value * direction);
-               },
-               [this](const data_t* data) -> float {
-                 std::lock_guard<std::mutex> lock(_mutex);
-                 float value = convDecode_positionTraj(data);
-                 if (this->_inverted.value == true)
-                 {
-                   value = value * -1.0;
-                 }
-                 return value;
-               },
-               0)
+  , _torque1a0("torque1a0", _calibration, 0)
+  , _torque1a1("torque1a1", _calibration, 0)
+  , _torque1a2("torque1a2", _calibration, 0)
+  , _torque1a3("torque1a3", _calibration, 0)
+  , _torque1a4("torque1a4", _calibration, 0)
   , _duration1("duration1", 0x74, 2, convEncode_PolyDuration, convDecode_PolyDuration, 0)
   , _trajPoly2Size("trajPoly2Size", 0x76, 1, convEncode_1Byte, convDecode_1Byte, 0)
-  , _traj2a0("traj2a0", 0x77, 4,
-             [this](data_t* data, float value) {
-               std::lock_guard<std::mutex> lock(this->_mutex);
-               int direction = 1;
-               if (this->_inverted.value == true)
-               {
-                 direction = -1;
-               }
-               convEncode_positionTraj(data, (value + this->_zero.value + OFFSET) * direction);
-             },
-             [this](const data_t* data) -> float {
-               std::lock_guard<std::mutex> lock(_mutex);
-               float value = convDecode_positionTraj(data);
-               if (this->_inverted.value == true)
-               {
-                 value = value * -1.0;
-               }
-               value = value - (this->_zero.value - OFFSET);
-               return value;
-             },
-             0)
-  , _traj2a1("traj2a1", 0x7B, 4,
-             [this](data_t* data, float value) {
-               std::lock_guard<std::mutex> lock(this->_mutex);
-               int direction = 1;
-               if (this->_inverted.value == true)
-               {
-                 direction = -1;
-               }
-               convEncode_positionTraj(data, value * direction);
-             },
-             [this](const data_t* data) -> float {
-               std::lock_guard<std::mutex> lock(_mutex);
-               float value = convDecode_positionTraj(data);
-               if (this->_inverted.value == true)
-               {
-                 value = value * -1.0;
-               }
-               return value;
-             },
-             0)
-  , _traj2a2("traj2a2", 0x7F, 4,
-             [this](data_t* data, float value) {
-               std::lock_guard<std::mutex> lock(this->_mutex);
-               int direction = 1;
-               if (this->_inverted.value == true)
-               {
-                 direction = -1;
-               }
-               convEncode_positionTraj(data, value * direction);
-             },
-             [this](const data_t* data) -> float {
-               std::lock_guard<std::mutex> lock(_mutex);
-               float value = convDecode_positionTraj(data);
-               if (this->_inverted.value == true)
-               {
-                 value = value * -1.0;
-               }
-               return value;
-             },
-             0)
-  , _traj2a3("traj2a3", 0x83, 4,
-             [this](data_t* data, float value) {
-               std::lock_guard<std::mutex> lock(this->_mutex);
-               int direction = 1;
-               if (this->_inverted.value == true)
-               {
-                 direction = -1;
-               }
-               convEncode_positionTraj(data, value * direction);
-             },
-             [this](const data_t* data) -> float {
-               std::lock_guard<std::mutex> lock(_mutex);
-               float value = convDecode_positionTraj(data);
-               if (this->_inverted.value == true)
-               {
-                 value = value * -1.0;
-               }
-               return value;
-             },
-             0)
-  , _traj2a4("traj2a4", 0x87, 4,
-             [this](data_t* data, float value) {
-               std::lock_guard<std::mutex> lock(this->_mutex);
-               int direction = 1;
-               if (this->_inverted.value == true)
-               {
-                 direction = -1;
-               }
-               convEncode_positionTraj(data, value * direction);
-             },
-             [this](const data_t* data) -> float {
-               std::lock_guard<std::mutex> lock(_mutex);
-               float value = convDecode_positionTraj(data);
-               if (this->_inverted.value == true)
-               {
-                 value = value * -1.0;
-               }
-               return value;
-             },
-             0)
+  , _traj2a0("traj2a0", _calibration, 0)
+  , _traj2a1("traj2a1", _calibration, 0)
+  , _traj2a2("traj2a2", _calibration, 0)
+  , _traj2a3("traj2a3", _calibration, 0)
+  , _traj2a4("traj2a4", _calibration, 0)
   , _torquePoly2Size("torquePoly2Size", 0x8B, 1, convEncode_1Byte, convDecode_1Byte, 0)
-  , _torque2a0("torque2a0", 0x8C, 4,
-               [this](data_t* data, float value) {
-                 std::lock_guard<std::mutex> lock(this->_mutex);
-                 int direction = 1;
-                 if (this->_inverted.value == true)
-                 {
-                   direction = -1;
-                 }
-                 convEncode_positionTraj(data, value * direction);
-               },
-               [this](const data_t* data) -> float {
-                 std::lock_guard<std::mutex> lock(_mutex);
-                 float value = convDecode_positionTraj(data);
-                 if (this->_inverted.value == true)
-                 {
-                   value = value * -1.0;
-                 }
-                 return value;
-               },
-               0)
-  , _torque2a1("torque2a1", 0x90, 4,
-               [this](data_t* data, float value) {
-                 std::lock_guard<std::mutex> lock(this->_mutex);
-                 int direction = 1;
-                 if (this->_inverted.value == true)
-                 {
-                   direction = -1;
-                 }
-                 convEncode_positionTraj(data, value * direction);
-               },
-               [this](const data_t* data) -> float {
-                 std::lock_guard<std::mutex> lock(_mutex);
-                 float value = convDecode_positionTraj(data);
-                 if (this->_inverted.value == true)
-                 {
-                   value = value * -1.0;
-                 }
-                 return value;
-               },
-               0)
-  , _torque2a2("torque2a2", 0x94, 4,
-               [this](data_t* data, float value) {
-                 std::lock_guard<std::mutex> lock(this->_mutex);
-                 int direction = 1;
-                 if (this->_inverted.value == true)
-                 {
-                   direction = -1;
-                 }
-                 convEncode_positionTraj(data, value * direction);
-               },
-               [this](const data_t* data) -> float {
-                 std::lock_guard<std::mutex> lock(_mutex);
-                 float value = convDecode_positionTraj(data);
-                 if (this->_inverted.value == true)
-                 {
-                   value = value * -1.0;
-                 }
-                 return value;
-               },
-               0)
-  , _torque2a3("torque2a3", 0x98, 4,
-               [this](data_t* data, float value) {
-                 std::lock_guard<std::mutex> lock(this->_mutex);
-                 int direction = 1;
-                 if (this->_inverted.value == true)
-                 {
-                   direction = -1;
-                 }
-                 convEncode_positionTraj(data, value * direction);
-               },
-               [this](const data_t* data) -> float {
-                 std::lock_guard<std::mutex> lock(_mutex);
-                 float value = convDecode_positionTraj(data);
-                 if (this->_inverted.value == true)
-                 {
-                   value = value * -1.0;
-                 }
-                 return value;
-               },
-               0)
-  , _torque2a4("torque2a4", 0x9C, 4,
-               [this](data_t* data, float value) {
-                 std::lock_guard<std::mutex> lock(this->_mutex);
-                 int direction = 1;
-                 if (this->_inverted.value == true)
-                 {
-                   direction = -1;
-                 }
-                 convEncode_positionTraj(data, value * direction);
-               },
-               [this](const data_t* data) -> float {
-                 std::lock_guard<std::mutex> lock(_mutex);
-                 float value = convDecode_positionTraj(data);
-                 if (this->_inverted.value == true)
-                 {
-                   value = value * -1.0;
-                 }
-                 return value;
-               },
-               0)
+  , _torque2a0("torque2a0", _calibration, 0)
+  , _torque2a1("torque2a1", _calibration, 0)
+  , _torque2a2("torque2a2", _calibration, 0)
+  , _torque2a3("torque2a3", _calibration, 0)
+  , _torque2a4("torque2a4", _calibration, 0)
   , _duration2("duration2", 0xA0, 2, convEncode_PolyDuration, convDecode_PolyDuration, 0)
   ,
 
@@ -517,17 +131,7 @@ Dynaban64::Dynaban64(const std::string& name, id_t id)
   , _torqueKp("torqueKp", 0xD0, 1, convEncode_2Bytes, convDecode_2Bytes, 0)
   , _goalTorque("goalTorque", 0xD2, 4, convEncode_float, convDecode_float, 0)
   , _predictiveCommandPeriod("predictiveCommandPeriod", 0xD6, 1, convEncode_float, convDecode_1Byte, 0)
-  , _voltagePWM("voltagePWM", 0xDA, 2,
-                [this](const data_t* data) -> float {
-                  std::lock_guard<std::mutex> lock(_mutex);
-                  float value = convDecode_voltagePWM(data);
-                  if (this->_inverted.value == true)
-                  {
-                    value = value * -1.0;
-                  }
-                  return value;
-                },
-                0)
+  , _voltagePWM("voltagePWM", _calibration, 0)
 {
   _duration1.setMinValue(0.0);
   _duration1.setMaxValue(6.5);
@@ -41,6 +41,20 @@ float convDecode_positionTraj(const data_t* buffer);
 
 float convDecode_voltagePWM(const data_t* buffer);
 
+/**
+ * Calibrated registers descriptors.
+ * All the trajectory positions have an offset of 180 degrees
+ * (also true for the MXs and the RXs). This is because dxl's zeros are
+ * not the same among different servomotors, so we unified them.
+ */
+typedef ConvFunctions<convEncode_positionTraj, convDecode_positionTraj> ConvPositionTraj;
+template <addr_t Addr>
+using DescTrajConstantDynaban = RegisterDescriptor<Addr, 4, ConvPositionTraj, CalibrationPosition, 180>;
+template <addr_t Addr>
+using DescTrajCoefDynaban = RegisterDescriptor<Addr, 4, ConvPositionTraj, CalibrationDirection>;
+typedef RegisterDescriptor<0xDA, 2, ConvFunctions<nullptr, convDecode_voltagePWM>, CalibrationDirection>
+    DescVoltagePWMDynaban;
+
 /**
  * Dynaban64
  *
@@ -272,35 +286,35 @@ protected:
 
   // Dynaban specific registers :
 
-  TypedRegisterInt _trajPoly1Size;  // 1 4A
-  TypedRegisterFloat _traj1a0;      // 4 4B
-  TypedRegisterFloat _traj1a1;      // 4 4F
-  TypedRegisterFloat _traj1a2;      // 4 53
-  TypedRegisterFloat _traj1a3;      // 4 57
-  TypedRegisterFloat _traj1a4;      // 4 5B
-
-  TypedRegisterInt _torquePoly1Size;  // 1 5F
-  TypedRegisterFloat _torque1a0;      // 4 60
-  TypedRegisterFloat _torque1a1;      // 4 64
-  TypedRegisterFloat _torque1a2;      // 4 68
-  TypedRegisterFloat _torque1a3;      // 4 6C
-  TypedRegisterFloat _torque1a4;      // 4 70
-
-  TypedRegisterFloat _duration1;  // 2 75
-
-  TypedRegisterInt _trajPoly2Size;  // 1 76
-  TypedRegisterFloat _traj2a0;      // 4 77
-  TypedRegisterFloat _traj2a1;      // 4 7B
-  TypedRegisterFloat _traj2a2;      // 4 7F
-  TypedRegisterFloat _traj2a3;      // 4 83
-  TypedRegisterFloat _traj2a4;      // 4 87
-
-  TypedRegisterInt _torquePoly2Size;  // 1 8B
-  TypedRegisterFloat _torque2a0;      // 4 8C
-  TypedRegisterFloat _torque2a1;      // 4 90
-  TypedRegisterFloat _torque2a2;      // 4 94
-  TypedRegisterFloat _torque2a3;      // 4 98
-  TypedRegisterFloat _torque2a4;      // 4 9C
+  TypedRegisterInt _trajPoly1Size;                            // 1 4A
+  DescribedRegister<DescTrajConstantDynaban<0x4B>> _traj1a0;  // 4 4B
+  DescribedRegister<DescTrajCoefDynaban<0x4F>> _traj1a1;      // 4 4F
+  DescribedRegister<DescTrajCoefDynaban<0x53>> _traj1a2;      // 4 53
+  DescribedRegister<DescTrajCoefDynaban<0x57>> _traj1a3;      // 4 57
+  DescribedRegister<DescTrajCoefDynaban<0x5B>> _traj1a4;      // 4 5B
+
+  TypedRegisterInt _torquePoly1Size;                        // 1 5F
+  DescribedRegister<DescTrajCoefDynaban<0x60>> _torque1a0;  // 4 60
+  DescribedRegister<DescTrajCoefDynaban<0x64>> _torque1a1;  // 4 64
+  DescribedRegister<DescTrajCoefDynaban<0x68>> _torque1a2;  // 4 68
+  DescribedRegister<DescTrajCoefDynaban<0x6C>> _torque1a3;  // 4 6C
+  DescribedRegister<DescTrajCoefDynaban<0x70>> _torque1a4;  // 4 70
+
+  TypedRegisterFloat _duration1;  // 2 74
+
+  TypedRegisterInt _trajPoly2Size;                            // 1 76
+  DescribedRegister<DescTrajConstantDynaban<0x77>> _traj2a0;  // 4 77
+  DescribedRegister<DescTrajCoefDynaban<0x7B>> _traj2a1;      // 4 7B
+  DescribedRegister<DescTrajCoefDynaban<0x7F>> _traj2a2;      // 4 7F
+  DescribedRegister<DescTrajCoefDynaban<0x83>> _traj2a3;      // 4 83
+  DescribedRegister<DescTrajCoefDynaban<0x87>> _traj2a4;      // 4 87
+
+  TypedRegisterInt _torquePoly2Size;                        // 1 8B
+  DescribedRegister<DescTrajCoefDynaban<0x8C>> _torque2a0;  // 4 8C
+  DescribedRegister<DescTrajCoefDynaban<0x90>> _torque2a1;  // 4 90
+  DescribedRegister<DescTrajCoefDynaban<0x94>> _torque2a2;  // 4 94
+  DescribedRegister<DescTrajCoefDynaban<0x98>> _torque2a3;  // 4 98
+  DescribedRegister<DescTrajCoefDynaban<0x9C>> _torque2a4;  // 4 9C
 
   TypedRegisterFloat _duration2;  // 2 A0
 
@@ -321,12 +335,12 @@ protected:
   TypedRegisterFloat _outputTorque;           // 4 C6
   TypedRegisterFloat _electricalTorque;       // 4 CA
 
-  TypedRegisterBool _frozenRamOn;             // 1 CE
-  TypedRegisterBool _useValuesNow;            // 1 CF
-  TypedRegisterInt _torqueKp;                 // 2 D0
-  TypedRegisterFloat _goalTorque;             // 4 D2
-  TypedRegisterInt _predictiveCommandPeriod;  // 1 D6
-  TypedRegisterFloat _voltagePWM;             // 1 DA
+  TypedRegisterBool _frozenRamOn;                        // 1 CE
+  TypedRegisterBool _useValuesNow;                       // 1 CF
+  TypedRegisterInt _torqueKp;                            // 2 D0
+  TypedRegisterFloat _goalTorque;                        // 4 D2
+  TypedRegisterInt _predictiveCommandPeriod;             // 1 D6
+  DescribedRegister<DescVoltagePWMDynaban> _voltagePWM;  // 1 DA
 };
 
 /**
@@ -336,7 +350,7 @@ template <>
 class ImplManager<Dynaban64> : public TypedManager<Dynaban64>
 {
 public:
-  inline static type_t typeNumber()
+  inline static constexpr type_t typeNumber()
   {
     return 0x0136;
   }
@@ -0,0 +1,223 @@
+#include <stdexcept>
+#include "Devices/DynabanTrajectoryFeeder.hpp"
+#include "Manager/BaseManager.hpp"
+
+namespace RhAL
+{
+/**
+ * Return given duration in
+ * seconds as a time point duration
+ */
+static TimePoint::duration toDuration(float duration)
+{
+  return std::chrono::duration_cast<TimePoint::duration>(TimeDurationFloat(duration));
+}
+
+DynabanTrajectoryFeeder::DynabanTrajectoryFeeder(BaseManager& manager, const std::vector<std::string>& names)
+  : _manager(manager), _group(manager, names), _feeds(names.size()), _state(StateIdle), _mode(0), _startCycle(0)
+{
+  for (Feed& feed : _feeds)
+  {
+    feed.hasLast = false;
+    feed.lastPosition = 0.0;
+    feed.lastVelocity = 0.0;
+    feed.isRunning = false;
+    feed.isNextPending = false;
+    feed.currentDuration = 0.0;
+    feed.segmentEnd = TimePoint();
+    feed.nextDuration = 0.0;
+  }
+}
+
+DynabanTrajectoryGroup& DynabanTrajectoryFeeder::group()
+{
+  return _group;
+}
+
+void DynabanTrajectoryFeeder::pushSegment(size_t index, const DynabanTrajectory& traj)
+{
+  // Same bound as the duration
+  // Register encoding
+  if (traj.duration <= 0.0 || traj.duration > 5.6)
+  {
+    throw std::logic_error("DynabanTrajectoryFeeder invalid segment duration");
+  }
+  _feeds.at(index).queue.push_back(traj);
+}
+
+void DynabanTrajectoryFeeder::pushWaypoint(size_t index, float position, float velocity, float duration)
+{
+  Feed& feed = _feeds.at(index);
+  if (!feed.hasLast)
+  {
+    feed.lastPosition = _group.dev(index).position().readValue().value;
+    feed.lastVelocity = 0.0;
+  }
+  // Cubic Hermite segment between
+  // last and given position and velocity
+  float p0 = feed.lastPosition;
+  float v0 = feed.lastVelocity;
+  float p1 = position;
+  float v1 = velocity;
+  float t = duration;
+  DynabanTrajectory traj = {};
+  traj.position[0] = p0;
+  traj.position[1] = v0;
+  traj.position[2] = (3.0 * (p1 - p0) - (2.0 * v0 + v1) * t) / (t * t);
+  traj.position[3] = (2.0 * (p0 - p1) + (v0 + v1) * t) / (t * t * t);
+  traj.positionSize = 4;
+  traj.torqueSize = 0;
+  traj.duration = duration;
+  pushSegment(index, traj);
+  feed.hasLast = true;
+  feed.lastPosition = position;
+  feed.lastVelocity = velocity;
+}
+
+size_t DynabanTrajectoryFeeder::countQueued(size_t index) const
+{
+  return _feeds.at(index).queue.size();
+}
+
+void DynabanTrajectoryFeeder::start(int mode)
+{
+  for (size_t i = 0; i < _feeds.size(); i++)
+  {
+    Feed& feed = _feeds[i];
+    if (feed.isRunning || feed.queue.empty())
+    {
+      continue;
+    }
+    _group.setFirstTrajectory(i, feed.queue.front());
+    feed.currentDuration = feed.queue.front().duration;
+    feed.queue.pop_front();
+    feed.isRunning = true;
+    feed.isNextPending = false;
+    if (!feed.queue.empty())
+    {
+      _group.setNextTrajectory(i, feed.queue.front());
+      feed.nextDuration = feed.queue.front().duration;
+      feed.queue.pop_front();
+      feed.isNextPending = true;
+    }
+  }
+  _group.upload();
+  _mode = mode;
+  // The flush running at upload time may have
+  // selected its writes before the upload,
+  // the next one performs it
+  _startCycle = _manager.cycleCount() + 2;
+  _state = StateStarting;
+}
+
+void DynabanTrajectoryFeeder::update()
+{
+  TimePoint now = _manager.clock().now();
+  if (_state == StateStarting)
+  {
+    // Wait for the upload to be flushed
+    // before starting all servos at next flush
+    if (_manager.cycleCount() < _startCycle)
+    {
+      return;
+    }
+    _group.startAll(_mode);
+    for (Feed& feed : _feeds)
+    {
+      feed.segmentEnd = now + toDuration(feed.currentDuration);
+    }
+    _state = StateRunning;
+    return;
+  }
+  if (_state != StateRunning)
+  {
+    return;
+  }
+
+  bool isAnyRunning = false;
+  bool isUpload = false;
+  for (size_t i = 0; i < _feeds.size(); i++)
+  {
+    Feed& feed = _feeds[i];
+    if (!feed.isRunning)
+    {
+      continue;
+    }
+    // Segments pushed after the buffer 2
+    // has been consumed
+    if (!feed.isNextPending && !feed.queue.empty())
+    {
+      _group.setNextTrajectory(i, feed.queue.front());
+      feed.nextDuration = feed.queue.front().duration;
+      feed.queue.pop_front();
+      feed.isNextPending = true;
+      isUpload = true;
+    }
+    isAnyRunning = true;
+    // No need to read before the
+    // expected end of current segment
+    if (now < feed.segmentEnd)
+    {
+      continue;
+    }
+    if (!feed.isNextPending)
+    {
+      // Last segment is over
+      feed.isRunning = false;
+      continue;
+    }
+    // Wait for the firmware to swap in
+    // the buffer 2 (copyNextBuffer reset to 0)
+    TypedRegisterInt& copyNextBuffer = _group.dev(i).copyNextBuffer();
+    ReadValueInt value = copyNextBuffer.readValue();
+    if (value.value == 0 && value.timestamp >= feed.segmentEnd)
+    {
+      feed.currentDuration = feed.nextDuration;
+      feed.segmentEnd += toDuration(feed.nextDuration);
+      feed.isNextPending = false;
+      if (!feed.queue.empty())
+      {
+        _group.setNextTrajectory(i, feed.queue.front());
+        feed.nextDuration = feed.queue.front().duration;
+        feed.queue.pop_front();
+        feed.isNextPending = true;
+        isUpload = true;
+      }
+    }
+    else
+    {
+      copyNextBuffer.askRead();
+    }
+  }
+  if (isUpload)
+  {
+    _group.upload();
+  }
+  if (!isAnyRunning)
+  {
+    _state = StateIdle;
+  }
+}
+
+void DynabanTrajectoryFeeder::stop()
+{
+  for (size_t i = 0; i < _feeds.size(); i++)
+  {
+    Feed& feed = _feeds[i];
+    feed.queue.clear();
+    feed.hasLast = false;
+    if (feed.isNextPending)
+    {
+      _group.stopAtTheEndOfTheTrajectory(i);
+      feed.isNextPending = false;
+    }
+  }
+  _group.upload();
+}
+
+bool DynabanTrajectoryFeeder::isRunning() const
+{
+  return _state != StateIdle;
+}
+
+}  // namespace RhAL
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <deque>
+#include <vector>
+#include <string>
+#include "Devices/DynabanTrajectoryGroup.hpp"
+#include "types.h"
+
+namespace RhAL
+{
+class BaseManager;
+
+/**
+ * DynabanTrajectoryFeeder
+ *
+ * Host side feeder of Dynaban64 double
+ * buffered polynomial trajectories.
+ * Each servo has a queue of segments, given
+ * either as polynomials or as waypoints
+ * (position and velocity reached after a
+ * duration, fitted as cubic Hermite segments).
+ * Once started, the next segment is kept in
+ * the servo buffer 2 and the following one is
+ * pushed as soon as the firmware consumes it.
+ * copyNextBuffer is only read after the expected
+ * end of the current segment, until the swap is
+ * seen. All servos uploads of a cycle are sent
+ * through one DynabanTrajectoryGroup upload.
+ * update() is expected to be called once per
+ * Manager cycle by a cooperative thread (after
+ * waitNextFlush()).
+ * Not thread safe.
+ */
+class DynabanTrajectoryFeeder
+{
+public:
+  /**
+   * Initialization with the Manager
+   * and fed Devices names.
+   * Throw std::logic_error if a Device
+   * is not a Dynaban64.
+   */
+  DynabanTrajectoryFeeder(BaseManager& manager, const std::vector<std::string>& names);
+
+  /**
+   * Return the underlying group
+   */
+  DynabanTrajectoryGroup& group();
+
+  /**
+   * Append given polynomial segment to the
+   * queue of the servo at given index.
+   * Throw std::logic_error if the duration
+   * is not in ]0:5.6] seconds.
+   */
+  void pushSegment(size_t index, const DynabanTrajectory& traj);
+
+  /**
+   * Append a segment reaching given position
+   * (degrees) and velocity (degrees/s) after given
+   * duration (seconds) to the queue of the servo at
+   * given index. The segment starts from the previous
+   * waypoint or, for the first one, from the last
+   * read position at rest.
+   */
+  void pushWaypoint(size_t index, float position, float velocity, float duration);
+
+  /**
+   * Return the number of segments waiting
+   * in the queue of the servo at given index
+   * (not yet uploaded)
+   */
+  size_t countQueued(size_t index) const;
+
+  /**
+   * Upload the first (and next) segments of all
+   * servos with queued segments. The trajectories
+   * are started all at once with given mode by the
+   * first update() call after the upload has
+   * been flushed.
+   */
+  void start(int mode = 3);
+
+  /**
+   * Push next segments consumed by the
+   * firmware and check for ended servos
+   */
+  void update();
+
+  /**
+   * Clear all queues and let the servos
+   * stop at the end of their current segment
+   */
+  void stop();
+
+  /**
+   * Return true if the feeder is
+   * started and a servo is still moving
+   */
+  bool isRunning() const;
+
+private:
+  /**
+   * Feeder state
+   */
+  enum State
+  {
+    StateIdle,
+    StateStarting,
+    StateRunning,
+  };
+
+  /**
+   * Feeding state of one servo
+   */
+  struct Feed
+  {
+    // Segments not yet uploaded
+    std::deque<DynabanTrajectory> queue;
+    // Last waypoint end state
+    bool hasLast;
+    float lastPosition;
+    float lastVelocity;
+    // Is a segment being followed
+    bool isRunning;
+    // Is a segment waiting in buffer 2
+    bool isNextPending;
+    // Current segment duration and expected end
+    float currentDuration;
+    TimePoint segmentEnd;
+    // Buffer 2 segment duration
+    float nextDuration;
+  };
+
+  /**
+   * Used Manager
+   */
+  BaseManager& _manager;
+
+  /**
+   * Servos group and feeding states
+   */
+  DynabanTrajectoryGroup _group;
+  std::vector<Feed> _feeds;
+
+  /**
+   * Current state, start mode and Manager
+   * cycle count at which the start upload
+   * is known to be flushed
+   */
+  State _state;
+  int _mode;
+  unsigned long _startCycle;
+};
+
+}  // namespace RhAL
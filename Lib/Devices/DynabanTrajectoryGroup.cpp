@@ -0,0 +1,163 @@
+#include <stdexcept>
+#include "Devices/DynabanTrajectoryGroup.hpp"
+#include "Manager/BaseManager.hpp"
+
+namespace RhAL
+{
+/**
+ * Copy given trajectory with unused
+ * coefficients set to zero
+ */
+static DynabanTrajectory normalize(const DynabanTrajectory& traj)
+{
+  if (traj.positionSize < 0 || traj.positionSize > 5 || traj.torqueSize < 0 || traj.torqueSize > 5)
+  {
+    throw std::logic_error("DynabanTrajectoryGroup invalid polynomial size");
+  }
+  DynabanTrajectory result = traj;
+  for (int i = traj.positionSize; i < 5; i++)
+  {
+    result.position[i] = 0.0;
+  }
+  for (int i = traj.torqueSize; i < 5; i++)
+  {
+    result.torque[i] = 0.0;
+  }
+  return result;
+}
+
+DynabanTrajectoryGroup::DynabanTrajectoryGroup(BaseManager& manager, const std::vector<std::string>& names)
+  : _manager(manager), _devices(), _staged()
+{
+  for (const std::string& name : names)
+  {
+    Dynaban64* dev = dynamic_cast<Dynaban64*>(&_manager.dev(name));
+    if (dev == nullptr)
+    {
+      throw std::logic_error("DynabanTrajectoryGroup Device is not a Dynaban64: " + name);
+    }
+    _devices.push_back(dev);
+    // Empty trajectories
+    Staged staged;
+    staged.traj1 = DynabanTrajectory();
+    staged.traj2 = DynabanTrajectory();
+    staged.copyNextBuffer = dev->copyNextBuffer().getWrittenValue();
+    staged.kind = UploadNone;
+    _staged.push_back(staged);
+  }
+}
+
+size_t DynabanTrajectoryGroup::size() const
+{
+  return _devices.size();
+}
+
+Dynaban64& DynabanTrajectoryGroup::dev(size_t index)
+{
+  return *_devices.at(index);
+}
+
+void DynabanTrajectoryGroup::setFirstTrajectory(size_t index, const DynabanTrajectory& traj)
+{
+  Staged& staged = _staged.at(index);
+  staged.traj1 = normalize(traj);
+  staged.copyNextBuffer = 0;
+  staged.kind = UploadFull;
+}
+
+void DynabanTrajectoryGroup::setNextTrajectory(size_t index, const DynabanTrajectory& traj)
+{
+  Staged& staged = _staged.at(index);
+  staged.traj2 = normalize(traj);
+  staged.copyNextBuffer = 1;
+  if (staged.kind < UploadNext)
+  {
+    staged.kind = UploadNext;
+  }
+}
+
+void DynabanTrajectoryGroup::stopAtTheEndOfTheTrajectory(size_t index)
+{
+  Staged& staged = _staged.at(index);
+  staged.copyNextBuffer = 0;
+  if (staged.kind < UploadFlag)
+  {
+    staged.kind = UploadFlag;
+  }
+}
+
+void DynabanTrajectoryGroup::upload()
+{
+  // All the Registers are selected by the same
+  // flush. Contiguous Registers of all servos
+  // with same upload kind share the same address
+  // and length and are merged in one sync write.
+  // The mode is not written since it would
+  // restart the servo trajectory.
+  _manager.atomicWrite([this]() {
+    for (size_t i = 0; i < _devices.size(); i++)
+    {
+      Dynaban64& dev = *_devices[i];
+      Staged& staged = _staged[i];
+      if (staged.kind == UploadFull)
+      {
+        writeBuffer1(dev, staged.traj1);
+        writeBuffer2(dev, staged.traj2);
+      }
+      else if (staged.kind == UploadNext)
+      {
+        writeBuffer2(dev, staged.traj2);
+      }
+      if (staged.kind != UploadNone)
+      {
+        dev.copyNextBuffer().writeValue(staged.copyNextBuffer);
+      }
+      staged.kind = UploadNone;
+    }
+  });
+}
+
+void DynabanTrajectoryGroup::startAll(int mode)
+{
+  _manager.atomicWrite([this, mode]() {
+    for (size_t i = 0; i < _devices.size(); i++)
+    {
+      _devices[i]->mode().writeValue(mode);
+    }
+  });
+}
+
+void DynabanTrajectoryGroup::askReadCopyNextBuffer()
+{
+  for (size_t i = 0; i < _devices.size(); i++)
+  {
+    _devices[i]->copyNextBuffer().askRead();
+  }
+}
+
+bool DynabanTrajectoryGroup::isReadyForNextTrajectory(size_t index) const
+{
+  return _devices.at(index)->copyNextBuffer().readValue().value == 0;
+}
+
+void DynabanTrajectoryGroup::writeBuffer1(Dynaban64& dev, const DynabanTrajectory& traj)
+{
+  dev.trajPoly1Size().writeValue(traj.positionSize);
+  dev.setPositionTrajectory1(traj.position[0], traj.position[1], traj.position[2], traj.position[3],
+                             traj.position[4]);
+  dev.torquePoly1Size().writeValue(traj.torqueSize);
+  dev.setTorqueTrajectory1(traj.torque[0], traj.torque[1], traj.torque[2], traj.torque[3], traj.torque[4]);
+  dev.duration1().writeValue(traj.duration);
+}
+
+void DynabanTrajectoryGroup::writeBuffer2(Dynaban64& dev, const DynabanTrajectory& traj)
+{
+  dev.trajPoly2Size().writeValue(traj.positionSize);
+  dev.setPositionTrajectory2(traj.position[0], traj.position[1], traj.position[2], traj.position[3],
+                             traj.position[4]);
+  dev.torquePoly2Size().writeValue(traj.torqueSize);
+  dev.setTorqueTrajectory2(traj.torque[0], traj.torque[1], traj.torque[2], traj.torque[3], traj.torque[4]);
+  dev.duration2().writeValue(traj.duration);
+}
+
+}  // namespace RhAL
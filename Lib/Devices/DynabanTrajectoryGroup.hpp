@@ -0,0 +1,167 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include "Devices/Dynaban64.hpp"
+
+namespace RhAL
+{
+class BaseManager;
+
+/**
+ * DynabanTrajectory
+ *
+ * One polynomial trajectory segment.
+ * Position coefficients in degrees,
+ * torque coefficients in N.m, duration
+ * in seconds. Only the first positionSize
+ * (resp. torqueSize) coefficients are used
+ * by the firmware (at most 5).
+ */
+struct DynabanTrajectory
+{
+  float position[5];
+  int positionSize;
+  float torque[5];
+  int torqueSize;
+  float duration;
+};
+
+/**
+ * DynabanTrajectoryGroup
+ *
+ * Multi servos polynomial trajectories
+ * upload for a fixed group of Dynaban64.
+ * Trajectories are staged per servo and
+ * uploaded together so that the Manager sends
+ * them as a few sync writes per cycle instead
+ * of one write per coefficient and per servo:
+ * - a first trajectory uploads the whole
+ *   contiguous trajectory block (0x4A-0xA1,
+ *   both buffers) and copyNextBuffer (0xA3),
+ * - a next trajectory uploads buffer 2
+ *   (0x76-0xA1) and copyNextBuffer.
+ * The mode (0xA2), whose write starts the
+ * trajectory, is never uploaded. startAll() writes
+ * the mode of all servos in one single sync write
+ * packet so that they start their trajectory
+ * at the same time.
+ * Requires the Manager schedule mode.
+ * Not thread safe: a group is supposed
+ * to be owned by a single control thread.
+ */
+class DynabanTrajectoryGroup
+{
+public:
+  /**
+   * Initialization with the Manager
+   * and grouped Devices names.
+   * Throw std::logic_error if a Device
+   * is not a Dynaban64.
+   */
+  DynabanTrajectoryGroup(BaseManager& manager, const std::vector<std::string>& names);
+
+  /**
+   * Return the number of grouped Devices
+   */
+  size_t size() const;
+
+  /**
+   * Return the Device at given
+   * index in group order
+   */
+  Dynaban64& dev(size_t index);
+
+  /**
+   * Stage the first trajectory (buffer 1)
+   * of the servo at given index. The servo will
+   * stop at its end unless a next trajectory
+   * is given.
+   */
+  void setFirstTrajectory(size_t index, const DynabanTrajectory& traj);
+
+  /**
+   * Stage the next trajectory (buffer 2)
+   * of the servo at given index, swapped in by
+   * the firmware at the end of the current one
+   */
+  void setNextTrajectory(size_t index, const DynabanTrajectory& traj);
+
+  /**
+   * Stage the stop of the servo at given
+   * index at the end of its current trajectory
+   */
+  void stopAtTheEndOfTheTrajectory(size_t index);
+
+  /**
+   * Mark all staged trajectories to be written
+   * together by next Manager flush
+   */
+  void upload();
+
+  /**
+   * Write given mode (see Dynaban64::mode())
+   * to all grouped servos in one sync write at next
+   * Manager flush. Call once the trajectories upload
+   * has been flushed to start them all at once.
+   */
+  void startAll(int mode);
+
+  /**
+   * Mark copyNextBuffer of all grouped
+   * servos to be read by next flush
+   */
+  void askReadCopyNextBuffer();
+
+  /**
+   * Return true if last read copyNextBuffer of the
+   * servo at given index is 0 (next trajectory consumed)
+   */
+  bool isReadyForNextTrajectory(size_t index) const;
+
+private:
+  /**
+   * Staged block upload kind
+   */
+  enum UploadKind
+  {
+    UploadNone = 0,
+    UploadFlag = 1,
+    UploadNext = 2,
+    UploadFull = 3,
+  };
+
+  /**
+   * Staged trajectory block
+   * of one servo
+   */
+  struct Staged
+  {
+    DynabanTrajectory traj1;
+    DynabanTrajectory traj2;
+    int copyNextBuffer;
+    UploadKind kind;
+  };
+
+  /**
+   * Used Manager
+   */
+  BaseManager& _manager;
+
+  /**
+   * Grouped Devices in user order
+   * and their staged blocks
+   */
+  std::vector<Dynaban64*> _devices;
+  std::vector<Staged> _staged;
+
+  /**
+   * Write the buffer 1 (0x4A-0x75) or
+   * buffer 2 (0x76-0xA1) Registers of
+   * given servo with given trajectory
+   */
+  static void writeBuffer1(Dynaban64& dev, const DynabanTrajectory& traj);
+  static void writeBuffer2(Dynaban64& dev, const DynabanTrajectory& traj);
+};
+
+}  // namespace RhAL
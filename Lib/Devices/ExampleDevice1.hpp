@@ -109,7 +109,7 @@ template <>
 class ImplManager<ExampleDevice1> : public TypedManager<ExampleDevice1>
 {
 public:
-  inline static type_t typeNumber()
+  inline static constexpr type_t typeNumber()
   {
     return 1;
   }
@@ -76,7 +76,7 @@ template <>
 class ImplManager<ExampleDevice2> : public TypedManager<ExampleDevice2>
 {
 public:
-  inline static type_t typeNumber()
+  inline static constexpr type_t typeNumber()
   {
     return 2;
   }
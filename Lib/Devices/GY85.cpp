@@ -27,52 +27,37 @@ static float gyroscopeDecode(const data_t* data)
   return GYRO_GAIN * convDecode_2Bytes_signed(data);
 }
 
-GY85::GY85(const std::string& name, id_t id)
-  : Device(name, id), filter(false), compassFilter(true), callback([] {}), sequence(0)
+/**
+ * Decode a sample slot
+ * (9 values then the sequence)
+ */
+static GY85::GY85Value sampleDecode(const data_t* data)
 {
-  for (int k = 0; k < GY85_VALUES; k++)
-  {
-    size_t offset = k * (9 * 2 + 4);
-    std::stringstream ss;
-    std::string prefix;
-    ss << "acc_" << k;
-    prefix = ss.str();
-
-    values[k].accX = std::shared_ptr<TypedRegisterFloat>(
-        new TypedRegisterFloat(prefix + "_x", 0x24 + offset, 2, accelerometerDecode, 1));
-    values[k].accY = std::shared_ptr<TypedRegisterFloat>(
-        new TypedRegisterFloat(prefix + "_y", 0x26 + offset, 2, accelerometerDecode, 1));
-    values[k].accZ = std::shared_ptr<TypedRegisterFloat>(
-        new TypedRegisterFloat(prefix + "_z", 0x28 + offset, 2, accelerometerDecode, 1));
-
-    ss.str("");
-    ss << "gyro_" << k;
-    prefix = ss.str();
-
-    values[k].gyroX = std::shared_ptr<TypedRegisterFloat>(
-        new TypedRegisterFloat(prefix + "_x", 0x2a + offset, 2, gyroscopeDecode, 1));
-    values[k].gyroY = std::shared_ptr<TypedRegisterFloat>(
-        new TypedRegisterFloat(prefix + "_y", 0x2c + offset, 2, gyroscopeDecode, 1));
-    values[k].gyroZ = std::shared_ptr<TypedRegisterFloat>(
-        new TypedRegisterFloat(prefix + "_z", 0x2e + offset, 2, gyroscopeDecode, 1));
-
-    ss.str("");
-    ss << "magn_" << k;
-    prefix = ss.str();
-
-    values[k].magnX = std::shared_ptr<TypedRegisterFloat>(
-        new TypedRegisterFloat(prefix + "_x", 0x30 + offset, 2, convDecode_2Bytes_signed, 1));
-    values[k].magnY = std::shared_ptr<TypedRegisterFloat>(
-        new TypedRegisterFloat(prefix + "_y", 0x32 + offset, 2, convDecode_2Bytes_signed, 1));
-    values[k].magnZ = std::shared_ptr<TypedRegisterFloat>(
-        new TypedRegisterFloat(prefix + "_z", 0x34 + offset, 2, convDecode_2Bytes_signed, 1));
-
-    ss.str("");
-    ss << "sequence_" << k;
-    values[k].sequence =
-        std::shared_ptr<TypedRegisterInt>(new TypedRegisterInt(ss.str(), 0x36 + offset, 4, convDecode_4Bytes, 1));
-  }
+  GY85::GY85Value value;
+  value.accX = accelerometerDecode(data + 0);
+  value.accY = accelerometerDecode(data + 2);
+  value.accZ = accelerometerDecode(data + 4);
+  value.gyroX = gyroscopeDecode(data + 6);
+  value.gyroY = gyroscopeDecode(data + 8);
+  value.gyroZ = gyroscopeDecode(data + 10);
+  value.magnX = convDecode_2Bytes_signed(data + 12);
+  value.magnY = convDecode_2Bytes_signed(data + 14);
+  value.magnZ = convDecode_2Bytes_signed(data + 16);
+  return value;
+}
+
+static uint32_t sequenceDecode(const data_t* data)
+{
+  return convDecode_4Bytes(data + 18);
+}
 
+GY85::GY85(const std::string& name, id_t id)
+  : Device(name, id)
+  , filter()
+  , callback([] {})
+  , sequence(0)
+  , _stream("samples", 0x24, GY85_VALUES, GY85_SLOT_LENGTH, sampleDecode, sequenceDecode, GY85_SAMPLE_PERIOD)
+{
   _kp_rollpitch = std::shared_ptr<ParameterNumber>(new ParameterNumber("kp_rollpitch", 0.02));
   _ki_rollpitch = std::shared_ptr<ParameterNumber>(new ParameterNumber("ki_rollpitch", 0.00002));
 
@@ -104,19 +89,7 @@ GY85::GY85(const std::string& name, id_t id)
 
 void GY85::onInit()
 {
-  for (int k = 0; k < GY85_VALUES; k++)
-  {
-    Device::registersList().add(values[k].accX.get());
-    Device::registersList().add(values[k].accY.get());
-    Device::registersList().add(values[k].accZ.get());
-    Device::registersList().add(values[k].gyroX.get());
-    Device::registersList().add(values[k].gyroY.get());
-    Device::registersList().add(values[k].gyroZ.get());
-    Device::registersList().add(values[k].magnX.get());
-    Device::registersList().add(values[k].magnY.get());
-    Device::registersList().add(values[k].magnZ.get());
-    Device::registersList().add(values[k].sequence.get());
-  }
+  Device::registersList().addBlock(&_stream.reg());
   Device::parametersList().add(_kp_rollpitch.get());
   Device::parametersList().add(_ki_rollpitch.get());
   Device::parametersList().add(_invertOrientation.get());
@@ -145,6 +118,11 @@ void GY85::setCallback(std::function<void()> callback_)
   callback = callback_;
 }
 
+SampleStream<GY85::GY85Value>& GY85::stream()
+{
+  return _stream;
+}
+
 void GY85::setGyroCalibration(float x, float y, float z)
 {
   std::lock_guard<std::mutex> lock(_mutex);
@@ -275,27 +253,27 @@ float GY85::getRoll()
 float GY85::getYawCompass()
 {
   std::lock_guard<std::mutex> lock(_mutex);
-  return compassFilter.yaw;
+  return filter.yawCompass;
 }
 float GY85::getPitchCompass()
 {
   std::lock_guard<std::mutex> lock(_mutex);
-  return compassFilter.pitch;
+  return filter.pitch;
 }
 float GY85::getRollCompass()
 {
   std::lock_guard<std::mutex> lock(_mutex);
-  return compassFilter.roll;
+  return filter.roll;
 }
 float GY85::getMagnAzimuth()
 {
   std::lock_guard<std::mutex> lock(_mutex);
-  return compassFilter.magnAzimuth;
+  return filter.magnAzimuth;
 }
 float GY85::getMagnHeading()
 {
   std::lock_guard<std::mutex> lock(_mutex);
-  return compassFilter.magnHeading;
+  return filter.magnHeading;
 }
 
 double GY85::getMaxStdDev()
@@ -329,27 +307,27 @@ ReadValueFloat GY85::getRollValue()
 ReadValueFloat GY85::getYawCompassValue()
 {
   std::lock_guard<std::mutex> lock(_mutex);
-  return ReadValueFloat(timestamp, compassFilter.yaw, isError);
+  return ReadValueFloat(timestamp, filter.yawCompass, isError);
 }
 ReadValueFloat GY85::getPitchCompassValue()
 {
   std::lock_guard<std::mutex> lock(_mutex);
-  return ReadValueFloat(timestamp, compassFilter.pitch, isError);
+  return ReadValueFloat(timestamp, filter.pitch, isError);
 }
 ReadValueFloat GY85::getRollCompassValue()
 {
   std::lock_guard<std::mutex> lock(_mutex);
-  return ReadValueFloat(timestamp, compassFilter.roll, isError);
+  return ReadValueFloat(timestamp, filter.roll, isError);
 }
 ReadValueFloat GY85::getMagnAzimuthValue()
 {
   std::lock_guard<std::mutex> lock(_mutex);
-  return ReadValueFloat(timestamp, compassFilter.magnAzimuth, isError);
+  return ReadValueFloat(timestamp, filter.magnAzimuth, isError);
 }
 ReadValueFloat GY85::getMagnHeadingValue()
 {
   std::lock_guard<std::mutex> lock(_mutex);
-  return ReadValueFloat(timestamp, compassFilter.magnHeading, isError);
+  return ReadValueFloat(timestamp, filter.magnHeading, isError);
 }
 
 Eigen::Matrix3d GY85::getMatrix()
@@ -360,7 +338,7 @@ Eigen::Matrix3d GY85::getMatrix()
 Eigen::Matrix3d GY85::getMatrixCompass()
 {
   std::lock_guard<std::mutex> lock(_mutex);
-  return compassFilter.getMatrix();
+  return filter.getMatrixCompass();
 }
 
 inline static float compensation(float value, float min, float max)
@@ -375,68 +353,38 @@ void GY85::onSwap()
 {
   _mutex.lock();
 
-  // Scanning all the values, pos will be the index of the
-  // current value if it is found, or the smallest sequence
-  // if not
-  int older = -1;
-  int newer = -1;
-  int currentPos = -1;
-  for (int k = 0; k < GY85_VALUES; k++)
+  // Retrieve all new samples
+  // from the read ring
+  unsigned long lost = _stream.countLost();
+  size_t count = _stream.update();
+  if (_stream.countLost() != lost)
   {
-    uint32_t seq = (uint32_t)values[k].sequence->readValue().value;
-    if (seq == sequence)
-    {
-      currentPos = k;
-    }
-    if (older < 0 || seq < (uint32_t)values[older].sequence->readValue().value)
-    {
-      older = k;
-    }
-    if (newer < 0 || seq > (uint32_t)values[newer].sequence->readValue().value)
-    {
-      newer = k;
-    }
-  }
-  if (currentPos < 0 && sequence != 0)
-  {
-    // XXX: The current sequence was not found in the buffers,
-    // we may have missed some values
-    // We assume thus that the current pos is the older value
+    // XXX: Some samples were overwritten in the
+    // buffers before being read
     std::cerr << "[GY-85] Missed packets, is the frequency too low?" << std::endl;
   }
 
-  timestamp = values[newer].sequence->readValue().timestamp;
+  timestamp = _stream.timestamp();
   timestamp -= TimeDurationMicro(long(_filterDelay->value * 1000000));  // take into account the filter delay
 
-  isError = values[newer].sequence->readValue().isError;
+  isError = _stream.isError();
 
-  bool updated = false;
-  while (currentPos != newer)
+  AHRS::Sample samples[GY85_VALUES];
+  const std::vector<StreamSample<GY85Value>>& batch = _stream.batch();
+  for (size_t i = 0; i < count; i++)
   {
-    if (currentPos < 0)
-    {
-      currentPos = older;
-    }
-    else
-    {
-      currentPos++;
-      if (currentPos >= GY85_VALUES)
-      {
-        currentPos = 0;
-      }
-    }
-
     // Update current values
-    accXRaw = values[currentPos].accX->readValue().value;
-    accYRaw = values[currentPos].accY->readValue().value;
-    accZRaw = values[currentPos].accZ->readValue().value;
-    gyroXRaw = values[currentPos].gyroX->readValue().value;
-    gyroYRaw = values[currentPos].gyroY->readValue().value;
-    gyroZRaw = values[currentPos].gyroZ->readValue().value;
-    magnXRaw = values[currentPos].magnX->readValue().value;
-    magnYRaw = values[currentPos].magnY->readValue().value;
-    magnZRaw = values[currentPos].magnZ->readValue().value;
-    sequence = (uint32_t)values[currentPos].sequence->readValue().value;
+    const GY85Value& value = batch[i].value;
+    accXRaw = value.accX;
+    accYRaw = value.accY;
+    accZRaw = value.accZ;
+    gyroXRaw = value.gyroX;
+    gyroYRaw = value.gyroY;
+    gyroZRaw = value.gyroZ;
+    magnXRaw = value.magnX;
+    magnYRaw = value.magnY;
+    magnZRaw = value.magnZ;
+    sequence = batch[i].sequence;
 
     // XXX: Apply calibration
     accX = compensation(accXRaw, _accXMin->value, _accXMax->value);
@@ -449,37 +397,24 @@ void GY85::onSwap()
     magnY = compensation(magnYRaw, _magnYMin->value, _magnYMax->value);
     magnZ = compensation(magnZRaw, _magnZMin->value, _magnZMax->value);
 
-    updated = true;
-
-    // Updating filters
-    compassFilter.accel[0] = filter.accel[0] = accX;
-    compassFilter.accel[1] = filter.accel[1] = accY;
-    compassFilter.accel[2] = filter.accel[2] = accZ;
-    compassFilter.gyro[0] = filter.gyro[0] = gyroX;
-    compassFilter.gyro[1] = filter.gyro[1] = gyroY;
-    compassFilter.gyro[2] = filter.gyro[2] = gyroZ;
-    compassFilter.magnetom[0] = filter.magnetom[0] = magnX;
-    compassFilter.magnetom[1] = filter.magnetom[1] = magnY;
-    compassFilter.magnetom[2] = filter.magnetom[2] = magnZ;
-    compassFilter.Kp_rollPitch = filter.Kp_rollPitch = _kp_rollpitch->value;
-    compassFilter.Ki_rollPitch = filter.Ki_rollPitch = _ki_rollpitch->value;
-
-    if (!isError)  // Do not update filter if the last read was an error????? Should not happen...
-    {
-      filter.update();
-      compassFilter.update();
-    }
-
-    filter.invertZ = _invertOrientation->value;
-    filter.invertX = _invertOrientationX->value;
-    filter.invertY = _invertOrientationY->value;
-    compassFilter.invertZ = _invertOrientation->value;
-    compassFilter.invertX = _invertOrientationX->value;
-    compassFilter.invertY = _invertOrientationY->value;
+    samples[i].accel << accX, accY, accZ;
+    samples[i].gyro << gyroX, gyroY, gyroZ;
+    samples[i].magnetom << magnX, magnY, magnZ;
+  }
+
+  // Updating the filter with the whole burst
+  filter.Kp_rollPitch = _kp_rollpitch->value;
+  filter.Ki_rollPitch = _ki_rollpitch->value;
+  filter.invertZ = _invertOrientation->value;
+  filter.invertX = _invertOrientationX->value;
+  filter.invertY = _invertOrientationY->value;
+  if (!isError)  // Do not update filter if the last read was an error????? Should not happen...
+  {
+    filter.update(samples, count);
   }
 
   _mutex.unlock();
-  if (updated)
+  if (count > 0)
   {
     callback();
   }
@@ -9,17 +9,27 @@
 #include "Manager/Device.hpp"
 #include "Manager/Register.hpp"
 #include "Manager/Parameter.hpp"
-#include "AHRS/Filter.hpp"
+#include "Manager/SampleStream.hpp"
+#include "AHRS/FusedFilter.hpp"
 #include "types.h"
 #include "timestamp.h"
 
 namespace RhAL
 {
 /**
- * How many buffers there is in the IMU
+ * How many buffers (sample slots)
+ * there is in the IMU
  */
 #define GY85_VALUES 5
 
+/**
+ * Length in bytes of a sample slot
+ * (9 values and the sequence number)
+ * and sensor sample period in seconds
+ */
+#define GY85_SLOT_LENGTH (9 * 2 + 4)
+#define GY85_SAMPLE_PERIOD 0.01
+
 /**
  * GY-85 Inertial Measurement Unit (IMU)
  */
@@ -27,20 +37,13 @@ class GY85 : public Device
 {
 public:
   /**
-   * A value in the device
+   * A raw sample in the device
    */
   struct GY85Value
   {
-    std::shared_ptr<TypedRegisterFloat> accX;
-    std::shared_ptr<TypedRegisterFloat> accY;
-    std::shared_ptr<TypedRegisterFloat> accZ;
-    std::shared_ptr<TypedRegisterFloat> gyroX;
-    std::shared_ptr<TypedRegisterFloat> gyroY;
-    std::shared_ptr<TypedRegisterFloat> gyroZ;
-    std::shared_ptr<TypedRegisterFloat> magnX;
-    std::shared_ptr<TypedRegisterFloat> magnY;
-    std::shared_ptr<TypedRegisterFloat> magnZ;
-    std::shared_ptr<TypedRegisterInt> sequence;
+    float accX, accY, accZ;
+    float gyroX, gyroY, gyroZ;
+    float magnX, magnY, magnZ;
   };
 
   /**
@@ -111,12 +114,19 @@ public:
    */
   void setGyroCalibration(float x, float y, float z);
 
+  /**
+   * Raw samples stream. Samples can be
+   * consumed with stream().pop() by
+   * one user thread.
+   */
+  SampleStream<GY85Value>& stream();
+
 protected:
   /**
-   * The IMU filter
+   * The IMU filter (with and
+   * without compass outputs)
    */
-  AHRS::Filter filter;
-  AHRS::Filter compassFilter;
+  AHRS::FusedFilter filter;
 
   /**
    * A callback that is invoked after a filtering
@@ -167,9 +177,9 @@ protected:
   bool isError;
 
   /**
-   * Register
+   * On board samples ring
    */
-  struct GY85Value values[GY85_VALUES];
+  SampleStream<GY85Value> _stream;
 
   /**
    * Inherit.
@@ -190,7 +200,7 @@ template <>
 class ImplManager<GY85> : public TypedManager<GY85>
 {
 public:
-  inline static type_t typeNumber()
+  inline static constexpr type_t typeNumber()
   {
     return 350;
   }
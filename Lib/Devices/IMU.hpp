@@ -90,7 +90,7 @@ template <>
 class ImplManager<IMU> : public TypedManager<IMU>
 {
 public:
-  inline static type_t typeNumber()
+  inline static constexpr type_t typeNumber()
   {
     return 253;
   }
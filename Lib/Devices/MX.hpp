@@ -45,6 +45,20 @@ void convEncode_AccelerationMx(data_t* buffer, float value);
  */
 float convDecode_AccelerationMx(const data_t* buffer);
 
+/**
+ * Calibrated registers descriptors
+ * (address, length, conversion, calibration policy)
+ */
+typedef RegisterDescriptor<0x1E, 2, ConvFunctions<convEncode_PositionMx, convDecode_PositionMx>, CalibrationPosition>
+    DescGoalPositionMx;
+typedef RegisterDescriptor<0x20, 2, ConvFunctions<convEncode_SpeedMx, convDecode_SpeedMx>, CalibrationDirection>
+    DescGoalSpeedMx;
+typedef RegisterDescriptor<0x24, 2, ConvFunctions<nullptr, convDecode_PositionMx>, CalibrationPosition> DescPositionMx;
+typedef RegisterDescriptor<0x26, 2, ConvFunctions<nullptr, convDecode_SpeedMx>, CalibrationDirection> DescSpeedMx;
+typedef RegisterDescriptor<0x49, 1, ConvFunctions<convEncode_AccelerationMx, convDecode_AccelerationMx>,
+                           CalibrationDirection>
+    DescGoalAccelerationMx;
+
 /**
  * MX
  *
@@ -63,10 +77,17 @@ public:
   MX(const std::string& name, id_t id);
 
   /**
-   * Applies the configuration to the motors.
+   * Report the desired configuration of the motors.
    * Used to make sure the angle limits are what they should be.
    */
-  virtual void setConfig() override;
+  virtual void getConfig(std::vector<ConfigValue>& config) override;
+
+  /**
+   * Inherit.
+   * MX also support 2M and the
+   * 2.25M, 2.5M and 3M high speeds.
+   */
+  virtual bool baudrateCode(unsigned long baudrate, addr_t& addr, data_t& code) const override;
 
   /**
    * Registers access
@@ -185,24 +206,24 @@ protected:
   // Flash/RAM limit (this info has no impact on the way the
   // registers are handled)
 
-  TypedRegisterBool _torqueEnable;       // 1 18
-  TypedRegisterBool _led;                // 1 19
-  TypedRegisterInt _DGain;               // 1 1A *
-  TypedRegisterInt _IGain;               // 1 1B *
-  TypedRegisterInt _PGain;               // 1 1C *
-  TypedRegisterFloat _goalPosition;      // 2 1E
-  TypedRegisterFloat _goalSpeed;         // 2 20
-  TypedRegisterFloat _torqueLimit;       // 2 22
-  TypedRegisterFloat _position;          // 2 24
-  TypedRegisterFloat _speed;             // 2 26
-  TypedRegisterFloat _load;              // 2 28
-  TypedRegisterFloat _voltage;           // 1 2A
-  TypedRegisterInt _temperature;         // 1 2B
-  TypedRegisterBool _registered;         // 1 2C
-  TypedRegisterBool _moving;             // 1 2E
-  TypedRegisterBool _lockEeprom;         // 1 2F
-  TypedRegisterFloat _punch;             // 2 30
-  TypedRegisterFloat _goalAcceleration;  // 1 49 *
+  TypedRegisterBool _torqueEnable;                              // 1 18
+  TypedRegisterBool _led;                                       // 1 19
+  TypedRegisterInt _DGain;                                      // 1 1A *
+  TypedRegisterInt _IGain;                                      // 1 1B *
+  TypedRegisterInt _PGain;                                      // 1 1C *
+  DescribedRegister<DescGoalPositionMx> _goalPosition;          // 2 1E
+  DescribedRegister<DescGoalSpeedMx> _goalSpeed;                // 2 20
+  TypedRegisterFloat _torqueLimit;                              // 2 22
+  DescribedRegister<DescPositionMx> _position;                  // 2 24
+  DescribedRegister<DescSpeedMx> _speed;                        // 2 26
+  TypedRegisterFloat _load;                                     // 2 28
+  TypedRegisterFloat _voltage;                                  // 1 2A
+  TypedRegisterInt _temperature;                                // 1 2B
+  TypedRegisterBool _registered;                                // 1 2C
+  TypedRegisterBool _moving;                                    // 1 2E
+  TypedRegisterBool _lockEeprom;                                // 1 2F
+  TypedRegisterFloat _punch;                                    // 2 30
+  DescribedRegister<DescGoalAccelerationMx> _goalAcceleration;  // 1 49 *
 };
 
 }  // namespace RhAL
@@ -58,7 +58,7 @@ template <>
 class ImplManager<MX106> : public TypedManager<MX106>
 {
 public:
-  inline static type_t typeNumber()
+  inline static constexpr type_t typeNumber()
   {
     return 0x0140;
   }
@@ -32,7 +32,7 @@ template <>
 class ImplManager<MX12> : public TypedManager<MX12>
 {
 public:
-  inline static type_t typeNumber()
+  inline static constexpr type_t typeNumber()
   {
     return 0x168;
   }
@@ -32,7 +32,7 @@ template <>
 class ImplManager<MX28> : public TypedManager<MX28>
 {
 public:
-  inline static type_t typeNumber()
+  inline static constexpr type_t typeNumber()
   {
     return 0x001D;
   }
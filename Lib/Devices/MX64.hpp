@@ -80,7 +80,7 @@ template <>
 class ImplManager<MX64> : public TypedManager<MX64>
 {
 public:
-  inline static type_t typeNumber()
+  inline static constexpr type_t typeNumber()
   {
     return 0x0136;
   }
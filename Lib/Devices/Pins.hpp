@@ -61,7 +61,7 @@ template <>
 class ImplManager<Pins> : public TypedManager<Pins>
 {
 public:
-  inline static type_t typeNumber()
+  inline static constexpr type_t typeNumber()
   {
     return 6000;
   }
@@ -268,7 +268,7 @@ template <int GAUGES>
 class ImplManager<PressureSensor<GAUGES>> : public TypedManager<PressureSensor<GAUGES>>
 {
 public:
-  inline static type_t typeNumber()
+  inline static constexpr type_t typeNumber()
   {
     return 5000 + GAUGES;
   }
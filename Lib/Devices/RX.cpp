@@ -176,73 +176,11 @@ RX::RX(const std::string& name, id_t id)
                          true)
   , _complianceSlopeCW("complianceSlopeCW", 0x1C, 1, convEncode_ComplianceSlope, convDecode_ComplianceSlope, 0, true)
   , _complianceSlopeCCW("complianceSlopeCCW", 0x1D, 1, convEncode_ComplianceSlope, convDecode_ComplianceSlope, 0, true)
-  , _goalPosition("goalPosition", 0x1E, 2,
-                  [this](data_t* data, float value) {
-                    std::lock_guard<std::mutex> lock(this->_mutex);
-                    value = value + this->_zero.value;
-                    if (this->_inverted.value == true)
-                    {
-                      value = value * -1.0;
-                    }
-                    convEncode_PositionRx(data, value);
-                  },
-                  [this](const data_t* data) -> float {
-                    float value = convDecode_PositionRx(data);
-                    std::lock_guard<std::mutex> lock(this->_mutex);
-                    if (this->_inverted.value == true)
-                    {
-                      value = value * -1.0;
-                    }
-                    value = value - this->_zero.value;
-                    return value;
-                  },
-                  0, true)
-  , _goalSpeed("goalSpeed", 0x20, 2,
-               [this](data_t* data, float value) {
-                 std::lock_guard<std::mutex> lock(this->_mutex);
-                 int direction = 1;
-                 if (this->_inverted.value == true)
-                 {
-                   direction = -1;
-                 }
-                 convEncode_SpeedRx(data, value * direction);
-               },
-               [this](const data_t* data) -> float {
-                 std::lock_guard<std::mutex> lock(_mutex);
-                 float value = convDecode_SpeedRx(data);
-                 int direction = 1;
-                 if (this->_inverted.value == true)
-                 {
-                   direction = -1;
-                 }
-                 return value * direction;
-               },
-               0, true)
+  , _goalPosition("goalPosition", _calibration, 0, true)
+  , _goalSpeed("goalSpeed", _calibration, 0, true)
   , _torqueLimit("torqueLimit", 0x22, 2, convEncode_torque, convDecode_torque, 0, true)
-  , _position("position", 0x24, 2,
-              [this](const data_t* data) -> float {
-                std::lock_guard<std::mutex> lock(this->_mutex);
-                float value = convDecode_PositionRx(data);
-                if (this->_inverted.value == true)
-                {
-                  value = value * -1.0;
-                }
-                value = value - this->_zero.value;
-                return value;
-              },
-              1, false)
-  , _speed("speed", 0x26, 2,
-           [this](const data_t* data) -> float {
-             std::lock_guard<std::mutex> lock(this->_mutex);
-             float value = convDecode_SpeedRx(data);
-             int direction = 1;
-             if (this->_inverted.value == true)
-             {
-               direction = -1;
-             }
-             return value * direction;
-           },
-           0, true)
+  , _position("position", _calibration, 1, false)
+  , _speed("speed", _calibration, 0, true)
   , _load("load", 0x28, 2, convDecode_torque, 0, true)
   , _voltage("voltage", 0x2A, 1, convDecode_voltage, 100)
   , _temperature("temperature", 0x2B, 1, convDecode_temperature, 100)
@@ -300,19 +238,12 @@ RX::RX(const std::string& name, id_t id)
   _torqueLimit.setStepValue(0.000977517);  // 1.0/1023
 }
 
-void RX::setConfig()
+void RX::getConfig(std::vector<ConfigValue>& config)
 {
-  float angleLimit1 = _angleLimitCW.readValue().value;
-  float angleLimit2 = _angleLimitCCW.readValue().value;
-  if (abs(angleLimit1 - _angleLimitCWParameter.value) > _angleLimitCW.getStepValue() / 2.0 ||
-      abs(angleLimit2 - _angleLimitCCWParameter.value) > _angleLimitCCW.getStepValue() / 2.0)
-  {
-    // Setting the angle limits to what they should be
-    angleLimit1 = _angleLimitCWParameter.value;
-    angleLimit2 = _angleLimitCCWParameter.value;
-    _angleLimitCW.writeValue(angleLimit1);
-    _angleLimitCCW.writeValue(angleLimit2);
-  }
+  // Enforce the angle limits
+  // from Parameters
+  config.push_back(ConfigValue(_angleLimitCW, (float)_angleLimitCWParameter.value));
+  config.push_back(ConfigValue(_angleLimitCCW, (float)_angleLimitCCWParameter.value));
 }
 
 TypedRegisterFloat& RX::angleLimitCW()
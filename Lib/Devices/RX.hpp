@@ -57,6 +57,17 @@ void convEncode_ComplianceSlope(data_t* buffer, int value);
  */
 int convDecode_ComplianceSlope(const data_t* buffer);
 
+/**
+ * Calibrated registers descriptors
+ * (address, length, conversion, calibration policy)
+ */
+typedef RegisterDescriptor<0x1E, 2, ConvFunctions<convEncode_PositionRx, convDecode_PositionRx>, CalibrationPosition>
+    DescGoalPositionRx;
+typedef RegisterDescriptor<0x20, 2, ConvFunctions<convEncode_SpeedRx, convDecode_SpeedRx>, CalibrationDirection>
+    DescGoalSpeedRx;
+typedef RegisterDescriptor<0x24, 2, ConvFunctions<nullptr, convDecode_PositionRx>, CalibrationPosition> DescPositionRx;
+typedef RegisterDescriptor<0x26, 2, ConvFunctions<nullptr, convDecode_SpeedRx>, CalibrationDirection> DescSpeedRx;
+
 /**
  * RX
  *
@@ -71,11 +82,11 @@ public:
   RX(const std::string& name, id_t id);
 
   /**
-   * Applies the configuration to the motors.
+   * Report the desired configuration of the motors.
    * Used to make sure the angle limits
    * are what they should be.
    */
-  virtual void setConfig() override;
+  virtual void getConfig(std::vector<ConfigValue>& config) override;
 
   /**
    * Registers access
@@ -188,24 +199,24 @@ protected:
 
   // Flash/RAM limit (this info has no impact on the way the registers are handled)
 
-  TypedRegisterBool _torqueEnable;          // 1 18
-  TypedRegisterBool _led;                   // 1 19
-  TypedRegisterFloat _complianceMarginCW;   // 1 1A *
-  TypedRegisterFloat _complianceMarginCCW;  // 1 1B *
-  TypedRegisterInt _complianceSlopeCW;      // 1 1C *
-  TypedRegisterInt _complianceSlopeCCW;     // 1 1D *
-  TypedRegisterFloat _goalPosition;         // 2 1E
-  TypedRegisterFloat _goalSpeed;            // 2 20
-  TypedRegisterFloat _torqueLimit;          // 2 22
-  TypedRegisterFloat _position;             // 2 24
-  TypedRegisterFloat _speed;                // 2 26
-  TypedRegisterFloat _load;                 // 2 28
-  TypedRegisterFloat _voltage;              // 1 2A
-  TypedRegisterInt _temperature;            // 1 2B
-  TypedRegisterBool _registered;            // 1 2C
-  TypedRegisterBool _moving;                // 1 2E
-  TypedRegisterBool _lockEeprom;            // 1 2F
-  TypedRegisterFloat _punch;                // 2 30
+  TypedRegisterBool _torqueEnable;                      // 1 18
+  TypedRegisterBool _led;                               // 1 19
+  TypedRegisterFloat _complianceMarginCW;               // 1 1A *
+  TypedRegisterFloat _complianceMarginCCW;              // 1 1B *
+  TypedRegisterInt _complianceSlopeCW;                  // 1 1C *
+  TypedRegisterInt _complianceSlopeCCW;                 // 1 1D *
+  DescribedRegister<DescGoalPositionRx> _goalPosition;  // 2 1E
+  DescribedRegister<DescGoalSpeedRx> _goalSpeed;        // 2 20
+  TypedRegisterFloat _torqueLimit;                      // 2 22
+  DescribedRegister<DescPositionRx> _position;          // 2 24
+  DescribedRegister<DescSpeedRx> _speed;                // 2 26
+  TypedRegisterFloat _load;                             // 2 28
+  TypedRegisterFloat _voltage;                          // 1 2A
+  TypedRegisterInt _temperature;                        // 1 2B
+  TypedRegisterBool _registered;                        // 1 2C
+  TypedRegisterBool _moving;                            // 1 2E
+  TypedRegisterBool _lockEeprom;                        // 1 2F
+  TypedRegisterFloat _punch;                            // 2 30
 };
 
 }  // namespace RhAL
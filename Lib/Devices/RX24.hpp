@@ -32,7 +32,7 @@ template <>
 class ImplManager<RX24> : public TypedManager<RX24>
 {
 public:
-  inline static type_t typeNumber()
+  inline static constexpr type_t typeNumber()
   {
     return 0x18;
   }
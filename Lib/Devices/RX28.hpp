@@ -32,7 +32,7 @@ template <>
 class ImplManager<RX28> : public TypedManager<RX28>
 {
 public:
-  inline static type_t typeNumber()
+  inline static constexpr type_t typeNumber()
   {
     return 0x001C;
   }
@@ -32,7 +32,7 @@ template <>
 class ImplManager<RX64> : public TypedManager<RX64>
 {
 public:
-  inline static type_t typeNumber()
+  inline static constexpr type_t typeNumber()
   {
     return 0x0040;
   }
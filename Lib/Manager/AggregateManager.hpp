@@ -2,9 +2,12 @@
 
 #include <json/json.h>
 #include <type_traits>
+#include <array>
+#include <stdexcept>
 #include "Device.hpp"
 #include "TypedManager.hpp"
 #include "BaseManager.hpp"
+#include "DeviceGroup.hpp"
 
 namespace RhAL
 {
@@ -39,6 +42,114 @@ struct is_type_in_pack<T> : std::false_type
 {
 };
 
+/**
+ * Trait type giving at compile time the
+ * index of type T in the variadic type
+ * list Types (T has to be in the list)
+ */
+template <typename T, typename... Types>
+struct type_index_in_pack;
+// Found case
+template <typename T, typename... Types>
+struct type_index_in_pack<T, T, Types...> : std::integral_constant<size_t, 0>
+{
+};
+// Specialization to iterate over Types pack
+template <typename T, typename U, typename... Types>
+struct type_index_in_pack<T, U, Types...>
+  : std::integral_constant<size_t, 1 + type_index_in_pack<T, Types...>::value>
+{
+};
+
+/**
+ * Return the TypeNumberTable size for given
+ * types count (power of 2 at least twice
+ * the types count)
+ */
+constexpr size_t typeNumberTableSize(size_t count)
+{
+  size_t size = 2;
+  while (size < 2 * count)
+  {
+    size *= 2;
+  }
+  return size;
+}
+
+/**
+ * TypeNumberTable
+ *
+ * Compile time built open addressing hash
+ * table mapping Device type model numbers
+ * to their index in the Manager variadic
+ * type list (at most half full, constant
+ * time lookup). Duplicated model numbers
+ * fail the compilation.
+ */
+template <size_t N>
+struct TypeNumberTable
+{
+  /**
+   * Table size
+   */
+  static constexpr size_t Size = typeNumberTableSize(N);
+
+  /**
+   * Model numbers and associated
+   * type indexes plus one (0 is empty)
+   */
+  type_t numbers[Size];
+  size_t indexes[Size];
+
+  /**
+   * Build the table from given
+   * model numbers in type list order
+   */
+  constexpr TypeNumberTable(const type_t (&types)[N]) : numbers{}, indexes{}
+  {
+    for (size_t i = 0; i < N; i++)
+    {
+      size_t k = hash(types[i]);
+      while (indexes[k] != 0)
+      {
+        if (numbers[k] == types[i])
+        {
+          throw std::logic_error("TypeNumberTable duplicated type number");
+        }
+        k = (k + 1) & (Size - 1);
+      }
+      numbers[k] = types[i];
+      indexes[k] = i + 1;
+    }
+  }
+
+  /**
+   * Return the type index of given
+   * model number or N if not found
+   */
+  constexpr size_t find(type_t type) const
+  {
+    size_t k = hash(type);
+    while (indexes[k] != 0)
+    {
+      if (numbers[k] == type)
+      {
+        return indexes[k] - 1;
+      }
+      k = (k + 1) & (Size - 1);
+    }
+    return N;
+  }
+
+  /**
+   * Multiplicative hash
+   */
+  static constexpr size_t hash(type_t type)
+  {
+    return ((uint32_t)type * 2654435761u >> 16) & (Size - 1);
+  }
+};
+
 /**
  * AggregateManager
  *
@@ -53,8 +164,18 @@ class AggregateManager : public BaseManager, public ImplManager<Types>...
   // Assert that variadic template given Types
   // is not empty
   static_assert(sizeof...(Types) != 0, "AggregateManager empty variatic template types");
+  // Type indexes are stored on 8 bits
+  static_assert(sizeof...(Types) < 255, "AggregateManager too many variatic template types");
 
 public:
+  /**
+   * Initialization
+   */
+  inline AggregateManager() : BaseManager(), ImplManager<Types>()..., _typeIndexById()
+  {
+    _typeIndexById.fill(0);
+  }
+
   /**
    * Typedef for devById/Name() methods return type.
    * Function return type is U given type.
@@ -104,10 +225,13 @@ public:
       // for fast id/name retrieving
       _devicesById[id] = dev;
       _devicesByName[name] = dev;
+      _typeIndexById[id] = type_index_in_pack<T, Types...>::value + 1;
       // Inject Manager pointer dependancy
       dev->setManager(this);
       // Run Parameters and Registers initialization
       dev->init();
+      // Notify user
+      _callbackDeviceAdded(dev);
     }
   }
 
@@ -137,7 +261,14 @@ public:
    */
   inline virtual void devAddByTypeNumber(id_t id, type_t type) override
   {
-    Impl<Types...>::runAddByType(this, id, type);
+    // Factory functions in type list order
+    static constexpr void (*factories[])(AggregateManager<Types...>*, id_t) = { &runAddByType<Types>... };
+    size_t index = _typeTable.find(type);
+    if (index == sizeof...(Types))
+    {
+      throw std::logic_error("AggregateManager add Device of type not supported: " + std::to_string(id));
+    }
+    factories[index](this, id);
   }
 
   /**
@@ -146,7 +277,7 @@ public:
    */
   inline virtual bool isTypeSupported(type_t type) const override
   {
-    return Impl<Types...>::runIsTypeSupported(type);
+    return _typeTable.find(type) != sizeof...(Types);
   }
 
   /**
@@ -191,19 +322,19 @@ public:
   // Implementations
   inline virtual type_t devTypeNumberById(id_t id) const override
   {
-    return Impl<Types...>::runTypeNumberById(this, id);
+    return _typeNumbers[typeIndexById(id)];
   }
   inline type_t devTypeNumberByName(const std::string& name) const
   {
-    return Impl<Types...>::runTypeNumberByName(this, name);
+    return _typeNumbers[typeIndexByName(name)];
   }
   inline virtual std::string devTypeNameById(id_t id) const override
   {
-    return Impl<Types...>::runTypeNameById(this, id);
+    return typeNameByIndex(typeIndexById(id));
   }
   inline std::string devTypeNameByName(const std::string& name) const
   {
-    return Impl<Types...>::runTypeNameByName(this, name);
+    return typeNameByIndex(typeIndexByName(name));
   }
 
   /**
@@ -358,6 +489,24 @@ public:
     }
   }
 
+  /**
+   * Build and return a group view over Devices
+   * of given template type T in given names order.
+   * Names are resolved once here.
+   * Throw std::logic_error if a name is not found
+   * or the Device is not of type T.
+   */
+  template <typename T>
+  inline DeviceGroup<T> group(const std::vector<std::string>& names)
+  {
+    std::vector<T*> devices;
+    for (const std::string& name : names)
+    {
+      devices.push_back(&devByName<T>(name));
+    }
+    return DeviceGroup<T>(*this, devices);
+  }
+
   /**
    * Return true if a device of given template type T
    * is already contained with given name or id
@@ -448,6 +597,65 @@ protected:
   }
 
 private:
+  /**
+   * Model numbers of contained types
+   * in type list order and compile
+   * time model number to type index table
+   */
+  static constexpr type_t _typeNumbers[sizeof...(Types)] = { ImplManager<Types>::typeNumber()... };
+  static constexpr TypeNumberTable<sizeof...(Types)> _typeTable = TypeNumberTable<sizeof...(Types)>(_typeNumbers);
+
+  /**
+   * Dense Device id to type
+   * index plus one (0 if not added)
+   */
+  std::array<uint8_t, IdDevEnd + 1> _typeIndexById;
+
+  /**
+   * Return the type index of given
+   * Device id or name.
+   * Throw std::logic_error if not found.
+   */
+  inline size_t typeIndexById(id_t id) const
+  {
+    if (id < 0 || id > IdDevEnd || _typeIndexById[id] == 0)
+    {
+      throw std::logic_error("AggregateManager type Device id not found: " + std::to_string(id));
+    }
+    return _typeIndexById[id] - 1;
+  }
+  inline size_t typeIndexByName(const std::string& name) const
+  {
+    auto it = _devicesByName.find(name);
+    if (it == _devicesByName.end())
+    {
+      throw std::logic_error("AggregateManager type Device name not found: " + name);
+    }
+    return typeIndexById(it->second->id());
+  }
+
+  /**
+   * Return the model name
+   * of given type index
+   */
+  inline static std::string typeNameByIndex(size_t index)
+  {
+    static std::string (*const names[])() = { &ImplManager<Types>::typeName... };
+    return names[index]();
+  }
+
+  /**
+   * Add a Device of given type
+   * with given id and generated name
+   */
+  template <typename T>
+  inline static void runAddByType(AggregateManager<Types...>* ptr, id_t id)
+  {
+    std::string name =
+        ImplManager<T>::typeName() + "_" + std::to_string(ptr->ImplManager<T>::devContainer().size() + 1);
+    ptr->devAdd<T>(id, name);
+  }
+
   /**
    * Implementation of iteration over contained
    * types using template variadic parameters and
@@ -460,61 +668,6 @@ private:
   template <typename T>
   struct Impl<T>
   {
-    // Add by type number
-    inline static void runAddByType(AggregateManager<Types...>* ptr, id_t id, type_t type)
-    {
-      if (ImplManager<T>::typeNumber() == type)
-      {
-        std::string name =
-            ImplManager<T>::typeName() + "_" + std::to_string(ptr->ImplManager<T>::devContainer().size() + 1);
-        ptr->devAdd<T>(id, name);
-      }
-      else
-      {
-        throw std::logic_error("AggregateManager add Device of type not supported: " + std::to_string(id));
-      }
-    }
-    // Is type supported
-    inline static bool runIsTypeSupported(type_t type)
-    {
-      return (ImplManager<T>::typeNumber() == type);
-    }
-    // Type number by Id
-    inline static type_t runTypeNumberById(const AggregateManager<Types...>* ptr, id_t id)
-    {
-      if (!ptr->devExistsById<T>(id))
-      {
-        throw std::logic_error("AggregateManager type Device id not found: " + std::to_string(id));
-      }
-      return ImplManager<T>::typeNumber();
-    }
-    // Type name by Id
-    inline static std::string runTypeNameById(const AggregateManager<Types...>* ptr, id_t id)
-    {
-      if (!ptr->devExistsById<T>(id))
-      {
-        throw std::logic_error("AggregateManager type Device id not found: " + std::to_string(id));
-      }
-      return ImplManager<T>::typeName();
-    }
-    // Type number by Name
-    inline static type_t runTypeNumberByName(const AggregateManager<Types...>* ptr, const std::string& name)
-    {
-      if (!ptr->devExistsByName<T>(name))
-      {
-        throw std::logic_error("AggregateManager type Device name not found: " + name);
-      }
-      return ImplManager<T>::typeNumber();
-    }
-    // Type name by Name
-    inline static std::string runTypeNameByName(const AggregateManager<Types...>* ptr, const std::string& name)
-    {
-      if (!ptr->devExistsByName<T>(name))
-      {
-        throw std::logic_error("AggregateManager type Device name not found: " + name);
-      }
-      return ImplManager<T>::typeName();
-    }
     // Save JSON
     inline static void runSaveJSON(const AggregateManager<Types...>* ptr, Json::Value& j)
     {
@@ -541,80 +694,6 @@ private:
   template <typename T, typename... Ts>
   struct Impl<T, Ts...>
   {
-    // Add by type number
-    inline static void runAddByType(AggregateManager<Types...>* ptr, id_t id, type_t type)
-    {
-      if (ImplManager<T>::typeNumber() == type)
-      {
-        std::string name =
-            ImplManager<T>::typeName() + "_" + std::to_string(ptr->ImplManager<T>::devContainer().size() + 1);
-        ptr->devAdd<T>(id, name);
-      }
-      else
-      {
-        Impl<Ts...>::runAddByType(ptr, id, type);
-      }
-    }
-    // Is type supported
-    inline static bool runIsTypeSupported(type_t type)
-    {
-      if (ImplManager<T>::typeNumber() == type)
-      {
-        return true;
-      }
-      else
-      {
-        return Impl<Ts...>::runIsTypeSupported(type);
-      }
-    }
-    // Type number by Id
-    inline static type_t runTypeNumberById(const AggregateManager<Types...>* ptr, id_t id)
-    {
-      if (ptr->devExistsById<T>(id))
-      {
-        return ImplManager<T>::typeNumber();
-      }
-      else
-      {
-        return Impl<Ts...>::runTypeNumberById(ptr, id);
-      }
-    }
-    // Type name by Id
-    inline static std::string runTypeNameById(const AggregateManager<Types...>* ptr, id_t id)
-    {
-      if (ptr->devExistsById<T>(id))
-      {
-        return ImplManager<T>::typeName();
-      }
-      else
-      {
-        return Impl<Ts...>::runTypeNameById(ptr, id);
-      }
-    }
-    // Type number by Name
-    inline static type_t runTypeNumberByName(const AggregateManager<Types...>* ptr, const std::string& name)
-    {
-      if (ptr->devExistsByName<T>(name))
-      {
-        return ImplManager<T>::typeNumber();
-      }
-      else
-      {
-        return Impl<Ts...>::runTypeNumberByName(ptr, name);
-      }
-    }
-    // Type name by Name
-    inline static std::string runTypeNameByName(const AggregateManager<Types...>* ptr, const std::string& name)
-    {
-      if (ptr->devExistsByName<T>(name))
-      {
-        return ImplManager<T>::typeName();
-      }
-      else
-      {
-        return Impl<Ts...>::runTypeNameByName(ptr, name);
-      }
-    }
     // Save JSON
     inline static void runSaveJSON(const AggregateManager<Types...>* ptr, Json::Value& j)
     {
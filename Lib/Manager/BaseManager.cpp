@@ -7,8 +7,14 @@ BaseManager::BaseManager()
   , _devicesByName()
   , _devicesById()
   , _parametersList()
+  , _callbackDeviceAdded([](Device* dev) { (void)dev; })
   , _mutexBus()
+  , _isEmergencyPending(false)
+  , _emergencyEpoch(0)
   , _sortedRegisters()
+  , _snapshot(std::make_shared<Snapshot>())
+  , _snapshotSpare()
+  , _recorder()
   , _readCycleCount(0)
   , _managerWaitUser1()
   , _managerWaitUser2()
@@ -23,37 +29,58 @@ BaseManager::BaseManager()
   , _currentThreadCooperativeWaiting2(0)
   , _stats()
   , _bus(nullptr)
+  , _captureBus(nullptr)
   , _protocol(nullptr)
   , _paramBusPort("port", "")
   , _paramBusBaudrate("baudrate", 1000000)
   , _paramProtocolName("protocol", "FakeProtocol")
+  , _paramBusCapture("busCapture", "")
   , _paramEnableSyncRead("enableSyncRead", true)
   , _paramEnableSyncWrite("enableSyncWrite", true)
   , _paramWaitWriteCheckResponse("waitWriteCheckResponse", false)
+  , _paramOptimizeLink("optimizeLink", false)
+  , _linkAppliedIds()
   , _paramThrowErrorOnScan("throwErrorOnScan", true)
   , _paramThrowErrorOnRead("throwErrorOnRead", true)
+  , _paramCallbackThreads("callbackThreads", 0)
+  , _paramCallbackCoalescing("callbackCoalescing", true)
+  , _paramRecorderPath("recorderPath", "")
+  , _paramRecorderCapacity("recorderCapacity", 65536)
 {
   // Registering all parameters
   _parametersList.add(&this->_paramScheduleMode);
   _parametersList.add(&_paramBusPort);
   _parametersList.add(&_paramBusBaudrate);
   _parametersList.add(&_paramProtocolName);
+  _parametersList.add(&_paramBusCapture);
   _parametersList.add(&_paramEnableSyncRead);
   _parametersList.add(&_paramEnableSyncWrite);
   _parametersList.add(&_paramWaitWriteCheckResponse);
+  _parametersList.add(&_paramOptimizeLink);
   _parametersList.add(&_paramThrowErrorOnScan);
   _parametersList.add(&_paramThrowErrorOnRead);
+  _parametersList.add(&_paramCallbackThreads);
+  _parametersList.add(&_paramCallbackCoalescing);
+  _parametersList.add(&_paramRecorderPath);
+  _parametersList.add(&_paramRecorderCapacity);
   // Initialize the low level communication
   initBus();
 }
 
 BaseManager::~BaseManager()
 {
+  // Run remaining callbacks
+  _callbackExecutor.stop();
   if (_protocol != nullptr)
   {
     delete _protocol;
     _protocol = nullptr;
   }
+  if (_captureBus != nullptr)
+  {
+    delete _captureBus;
+    _captureBus = nullptr;
+  }
   if (_bus != nullptr)
   {
     delete _bus;
@@ -167,15 +194,46 @@ void BaseManager::disableCooperativeThread()
 
 void BaseManager::emergencyStop()
 {
-  // Check for bus inited
-  if (_protocol == nullptr)
-  {
-    throw std::logic_error("BaseManager protocol not initialized");
+  // Raise the emergency flag first so that the
+  // Manager releases the bus as soon as possible.
+  // The shared mutex is not taken to not wait
+  // behind a whole flush() operation.
+  TimePoint pStart = _clock.load()->now();
+  _isEmergencyPending = true;
+  TimePoint pStop;
+  {
+    std::lock_guard<std::mutex> lockBus(_mutexBus);
+    // Check for bus inited (the Protocol
+    // is rebuilt under the bus mutex)
+    if (_protocol == nullptr)
+    {
+      _isEmergencyPending = false;
+      throw std::logic_error("BaseManager protocol not initialized");
+    }
+    try
+    {
+      _protocol->emergencyStop();
+    }
+    catch (...)
+    {
+      _isEmergencyPending = false;
+      throw;
+    }
+    pStop = _clock.load()->now();
+    _emergencyEpoch++;
+    _isEmergencyPending = false;
   }
+  // Statistics (the shared mutex is taken
+  // after the bus is released to keep
+  // the locking order)
   std::lock_guard<std::mutex> lock(CallManager::_mutex);
-  std::lock_guard<std::mutex> lockBus(_mutexBus);
   _stats.emergencyCount++;
-  _protocol->emergencyStop();
+  TimeDurationMicro duration = getTimeDuration<TimeDurationMicro>(pStart, pStop);
+  _stats.sumEmergencyLatency += duration;
+  if (_stats.maxEmergencyLatency < duration)
+  {
+    _stats.maxEmergencyLatency = duration;
+  }
 }
 
 void BaseManager::exitEmergencyState()
@@ -204,7 +262,7 @@ void BaseManager::waitNextFlush()
   // Lock the shared mutex
   std::unique_lock<std::mutex> lock(CallManager::_mutex);
   // Statistics
-  TimePoint pStart = getTimePoint();
+  TimePoint pStart = _clock.load()->now();
 
   // Retrieve cooperative state
   std::thread::id id = std::this_thread::get_id();
@@ -292,7 +350,7 @@ void BaseManager::waitNextFlush()
   }
 
   // Statistics
-  TimePoint pStop = getTimePoint();
+  TimePoint pStop = _clock.load()->now();
   _stats.waitManagerDuration += getTimeDuration<TimeDurationMicro>(pStart, pStop);
 
   // Release the shared mutex
@@ -320,6 +378,9 @@ void BaseManager::flush(bool isForceSwap)
   //(during wait, the shared mutex is released)
   //(The lock is taken once condition is reached)
   std::unique_lock<std::mutex> lock(CallManager::_mutex);
+  // Batches computed from now are dropped
+  // if an emergency stop is requested
+  unsigned long emergencyEpoch = _emergencyEpoch;
   // Statistics
   _stats.flushCount++;
   if (_stats.regReadPerFlushMax == 0)
@@ -348,7 +409,7 @@ void BaseManager::flush(bool isForceSwap)
     _stats.regWrittenPerFlushMax = _stats.regWrittenPerFlushAccu;
   }
   _stats.regWrittenPerFlushAccu = 0;
-  TimePoint pStart = getTimePoint();
+  TimePoint pStart = _clock.load()->now();
   if (_stats.lastFlushTimePoint != TimePoint())
   {
     TimeDurationMicro d = getTimeDuration<TimeDurationMicro>(_stats.lastFlushTimePoint, pStart);
@@ -374,6 +435,10 @@ void BaseManager::flush(bool isForceSwap)
   swapRead();
   // Call all Devices onSwap() callback
   swapCallBack();
+  // Sample running calibrations
+  _calibrator.update();
+  // Write interpolated Registers values
+  _interpolator.update(_clock.load()->now());
   // Select registers for read and write
   // and compute operation batching
   std::vector<BatchedRegisters> batchsRead = computeBatchedRegisters(true);
@@ -392,7 +457,7 @@ void BaseManager::flush(bool isForceSwap)
   // Open the second barrier.
   _isManagerBarrierOpen2 = true;
   // Statistics
-  TimePoint pStop = getTimePoint();
+  TimePoint pStop = _clock.load()->now();
   _stats.waitUsersDuration += getTimeDuration<TimeDurationMicro>(pStart, pStop);
   // Notify the users thread waiting on the second barrier.
   // Users are exiting from waitNextFlush().
@@ -402,8 +467,35 @@ void BaseManager::flush(bool isForceSwap)
 
   // Perform write operation on all batchs
   bool needsToWait = false;
+  bool isAborted = false;
   for (size_t i = 0; i < batchsWrite.size(); i++)
   {
+    // Drop all remaining operations if
+    // an emergency stop is requested
+    if (isEmergencyRequested(emergencyEpoch))
+    {
+      // Selected Registers are no longer marked
+      // for write. Not performed writes are set
+      // as failed to be written again next cycle.
+      unsigned long countErrors = 0;
+      for (size_t k = i; k < batchsWrite.size(); k++)
+      {
+        for (size_t j = 0; j < batchsWrite[k].regs.size(); j++)
+        {
+          for (Register* reg : batchsWrite[k].regs[j])
+          {
+            reg->writeError();
+          }
+          countErrors++;
+        }
+      }
+      lock.lock();
+      _stats.abortedBatchCount += batchsWrite.size() - i + batchsRead.size();
+      _stats.writeErrorCount += countErrors;
+      lock.unlock();
+      isAborted = true;
+      break;
+    }
     writeBatch(batchsWrite[i]);
     // Check if a written register is slow
     for (size_t j = 0; j < batchsWrite[i].regs.size(); j++)
@@ -419,15 +511,31 @@ void BaseManager::flush(bool isForceSwap)
   }
 
   // If a slow register was written, we need
-  // to wait a big amount of time
-  if (needsToWait)
+  // to wait a big amount of time.
+  // The wait is interrupted by emergency stop.
+  if (needsToWait && !isAborted)
   {
-    std::this_thread::sleep_for(std::chrono::milliseconds(SlowRegisterDelayMs));
+    TimePoint pWait = _clock.load()->now();
+    while (duration_ms(pWait, _clock.load()->now()) < SlowRegisterDelayMs && !isEmergencyRequested(emergencyEpoch))
+    {
+      _clock.load()->sleepFor(std::chrono::milliseconds(1));
+    }
   }
 
   // Perform read operation on all batchs
-  for (size_t i = 0; i < batchsRead.size(); i++)
+  for (size_t i = 0; i < batchsRead.size() && !isAborted; i++)
   {
+    // Drop all remaining operations if
+    // an emergency stop is requested.
+    // Not read registers are kept asked for read.
+    if (isEmergencyRequested(emergencyEpoch))
+    {
+      lock.lock();
+      _stats.abortedBatchCount += batchsRead.size() - i;
+      lock.unlock();
+      isAborted = true;
+      break;
+    }
     readBatch(batchsRead[i]);
   }
 
@@ -441,6 +549,24 @@ void BaseManager::flush(bool isForceSwap)
   }
 }
 
+unsigned long BaseManager::cycleCount() const
+{
+  return _readCycleCount;
+}
+
+void BaseManager::atomicWrite(std::function<void()> func)
+{
+  if (!isScheduleMode())
+  {
+    func();
+    return;
+  }
+  // Registers are selected for write
+  // under the shared mutex
+  std::lock_guard<std::mutex> lock(CallManager::_mutex);
+  func();
+}
+
 void BaseManager::forceSwap()
 {
   std::lock_guard<std::mutex> lock(CallManager::_mutex);
@@ -467,7 +593,7 @@ bool BaseManager::ping(id_t id)
   {
     throw std::logic_error("BaseManager protocol not initialized");
   }
-  bool response = _protocol->ping(id);
+  bool response = pingBus(id);
   if (_devicesById.count(id) == 1)
   {
     // If the device is register,
@@ -525,11 +651,15 @@ void BaseManager::scan()
   {
     it.second->setPresent(false);
   }
+  // Found Devices link configuration
+  // is unknown until the next configuration sync
+  _linkAppliedIds.clear();
+  applyLinkTiming();
   // Iterate over all possible Id
   for (id_t i = IdDevBegin; i <= IdDevEnd; i++)
   {
     // If the Device exist on the bus
-    if (_protocol->ping(i))
+    if (pingBus(i))
     {
       // Retrieve the model number
       type_t type;
@@ -597,7 +727,7 @@ bool BaseManager::checkDevices()
   bool isMissing = false;
   for (auto& dev : _devicesById)
   {
-    bool response = _protocol->ping(dev.first);
+    bool response = pingBus(dev.first);
     if (!response)
     {
       isMissing = true;
@@ -612,15 +742,437 @@ bool BaseManager::checkDevices()
   return !isMissing;
 }
 
-void BaseManager::setDevicesConfig()
+size_t BaseManager::setDevicesConfig()
+{
+  return syncDevicesConfig(false, _paramWaitWriteCheckResponse.value);
+}
+
+size_t BaseManager::syncDevicesConfig(bool isLinkOnly, bool isWriteStatus)
 {
+  // Desired configuration of one Device over
+  // the memory range covering all its values
+  struct ConfigSync
+  {
+    Device* dev;
+    addr_t addr;
+    size_t length;
+    std::vector<data_t> desired;
+    std::vector<bool> mask;
+    std::vector<data_t> current;
+    bool isRead;
+    bool isSlow;
+  };
+  std::vector<ConfigSync> syncs;
+  // Devices without link configuration
+  std::vector<id_t> noLinkIds;
   for (auto& dev : _devicesById)
   {
-    if (dev.second->isPresent())
+    if (!dev.second->isPresent())
+    {
+      continue;
+    }
+    std::vector<ConfigValue> config;
+    if (!isLinkOnly)
     {
       dev.second->setConfig();
+      dev.second->getConfig(config);
+    }
+    size_t configSize = config.size();
+    dev.second->getLinkConfig(config, _paramOptimizeLink.value, isWriteStatus);
+    if (config.size() == configSize)
+    {
+      noLinkIds.push_back(dev.first);
+    }
+    if (config.size() == 0)
+    {
+      continue;
+    }
+    ConfigSync sync;
+    sync.dev = dev.second;
+    sync.addr = config.front().reg->addr;
+    size_t end = sync.addr;
+    sync.isSlow = false;
+    for (const ConfigValue& value : config)
+    {
+      sync.addr = std::min(sync.addr, value.reg->addr);
+      end = std::max(end, value.reg->addr + value.reg->length);
+      sync.isSlow = sync.isSlow || value.reg->isSlowRegister;
+    }
+    sync.length = end - sync.addr;
+    sync.desired.assign(sync.length, 0);
+    sync.mask.assign(sync.length, false);
+    sync.current.assign(sync.length, 0);
+    sync.isRead = false;
+    for (const ConfigValue& value : config)
+    {
+      size_t offset = value.reg->addr - sync.addr;
+      for (size_t k = 0; k < value.reg->length; k++)
+      {
+        sync.desired[offset + k] = value.data[k];
+        sync.mask[offset + k] = true;
+      }
+    }
+    syncs.push_back(std::move(sync));
+  }
+
+  std::lock_guard<std::mutex> lockBus(_mutexBus);
+  // Check for initBus() called
+  if (_protocol == nullptr)
+  {
+    throw std::logic_error("BaseManager protocol not initialized");
+  }
+  // The fixed wait after write is used until
+  // the link configuration is known to be applied
+  _linkAppliedIds.clear();
+  if (_paramOptimizeLink.value)
+  {
+    _linkAppliedIds.insert(noLinkIds.begin(), noLinkIds.end());
+  }
+  applyLinkTiming();
+  if (syncs.size() == 0)
+  {
+    return 0;
+  }
+  // Read back the current configuration
+  // grouping Devices with the same range
+  std::map<std::pair<addr_t, size_t>, std::vector<size_t>> groupsRead;
+  for (size_t i = 0; i < syncs.size(); i++)
+  {
+    groupsRead[{ syncs[i].addr, syncs[i].length }].push_back(i);
+  }
+  for (const auto& group : groupsRead)
+  {
+    addr_t addr = group.first.first;
+    size_t length = group.first.second;
+    if (group.second.size() > 1 && _paramEnableSyncRead.value)
+    {
+      std::vector<id_t> ids;
+      std::vector<data_t*> datas;
+      for (size_t i : group.second)
+      {
+        ids.push_back(syncs[i].dev->id());
+        datas.push_back(syncs[i].current.data());
+      }
+      TimePoint pStart = _clock.load()->now();
+      std::vector<ResponseState> states = _protocol->syncRead(ids, addr, datas, length);
+      TimePoint pStop = _clock.load()->now();
+      _stats.syncReadCount++;
+      _stats.syncReadLength += length;
+      TimeDurationMicro duration = getTimeDuration<TimeDurationMicro>(pStart, pStop);
+      for (size_t k = 0; k < states.size(); k++)
+      {
+        _recorder.append(FlightRecordSync | FlightRecordForced, _readCycleCount, ids[k], addr, datas[k], length,
+                         states[k], pStop, duration);
+        ConfigSync& sync = syncs[group.second[k]];
+        sync.isRead = checkResponseState(states[k], sync.dev);
+      }
+    }
+    else
+    {
+      for (size_t i : group.second)
+      {
+        ConfigSync& sync = syncs[i];
+        TimePoint pStart = _clock.load()->now();
+        ResponseState state = _protocol->readData(sync.dev->id(), addr, sync.current.data(), length);
+        TimePoint pStop = _clock.load()->now();
+        _stats.readCount++;
+        _stats.readLength += length;
+        TimeDurationMicro duration = getTimeDuration<TimeDurationMicro>(pStart, pStop);
+        _recorder.append(FlightRecordForced, _readCycleCount, sync.dev->id(), addr, sync.current.data(), length, state,
+                         pStop, duration);
+        sync.isRead = checkResponseState(state, sync.dev);
+      }
     }
   }
+
+  // Diff against desired configuration and
+  // group differing ranges for writing
+  std::map<std::pair<addr_t, size_t>, std::vector<std::pair<id_t, const data_t*>>> groupsWrite;
+  std::set<id_t> written;
+  bool isSlow = false;
+  for (ConfigSync& sync : syncs)
+  {
+    if (sync.isRead)
+    {
+      // Single range from first to last
+      // differing byte (holes keep the read
+      // values and are written back unchanged)
+      size_t first = sync.length;
+      size_t last = 0;
+      for (size_t k = 0; k < sync.length; k++)
+      {
+        if (sync.mask[k] && sync.current[k] != sync.desired[k])
+        {
+          first = std::min(first, k);
+          last = k;
+          sync.current[k] = sync.desired[k];
+        }
+      }
+      if (first == sync.length)
+      {
+        continue;
+      }
+      groupsWrite[{ sync.addr + first, last - first + 1 }].push_back({ sync.dev->id(), sync.current.data() + first });
+    }
+    else
+    {
+      // Unknown current values, write
+      // all contiguous desired ranges
+      std::cerr << "BaseManager config read back failed, writing all values on device id: " << sync.dev->id()
+                << std::endl;
+      size_t k = 0;
+      while (k < sync.length)
+      {
+        if (!sync.mask[k])
+        {
+          k++;
+          continue;
+        }
+        size_t first = k;
+        while (k < sync.length && sync.mask[k])
+        {
+          k++;
+        }
+        groupsWrite[{ sync.addr + first, k - first }].push_back({ sync.dev->id(), sync.desired.data() + first });
+      }
+    }
+    written.insert(sync.dev->id());
+    isSlow = isSlow || sync.isSlow;
+  }
+  for (const auto& group : groupsWrite)
+  {
+    addr_t addr = group.first.first;
+    size_t length = group.first.second;
+    if (group.second.size() > 1 && _paramEnableSyncWrite.value)
+    {
+      std::vector<id_t> ids;
+      std::vector<const data_t*> datas;
+      for (const auto& entry : group.second)
+      {
+        ids.push_back(entry.first);
+        datas.push_back(entry.second);
+      }
+      TimePoint pStart = _clock.load()->now();
+      _protocol->syncWrite(ids, addr, datas, length);
+      TimePoint pStop = _clock.load()->now();
+      _stats.syncWriteCount++;
+      _stats.syncWriteLength += length;
+      TimeDurationMicro duration = getTimeDuration<TimeDurationMicro>(pStart, pStop);
+      for (size_t k = 0; k < ids.size(); k++)
+      {
+        _recorder.append(FlightRecordWrite | FlightRecordSync | FlightRecordForced, _readCycleCount, ids[k], addr,
+                         datas[k], length, 0, pStop, duration);
+      }
+    }
+    else
+    {
+      for (const auto& entry : group.second)
+      {
+        TimePoint pStart = _clock.load()->now();
+        _protocol->writeData(entry.first, addr, entry.second, length);
+        TimePoint pStop = _clock.load()->now();
+        _stats.writeCount++;
+        _stats.writeLength += length;
+        TimeDurationMicro duration = getTimeDuration<TimeDurationMicro>(pStart, pStop);
+        _recorder.append(FlightRecordWrite | FlightRecordForced, _readCycleCount, entry.first, addr, entry.second,
+                         length, 0, pStop, duration);
+      }
+    }
+  }
+  // Wait delay once in case
+  // of written slow registers
+  if (isSlow)
+  {
+    _clock.load()->sleepFor(std::chrono::milliseconds(SlowRegisterDelayMs));
+  }
+  // Link configuration is known to be applied on
+  // Devices whose current values have been read back
+  if (_paramOptimizeLink.value)
+  {
+    for (const ConfigSync& sync : syncs)
+    {
+      if (sync.isRead)
+      {
+        _linkAppliedIds.insert(sync.dev->id());
+      }
+    }
+  }
+  applyLinkTiming();
+
+  return written.size();
+}
+
+unsigned long BaseManager::negotiateBaudrate(const std::vector<unsigned long>& baudrates, unsigned int burst,
+                                             std::vector<std::pair<unsigned long, unsigned long>>* report)
+{
+  std::lock_guard<std::mutex> lock(CallManager::_mutex);
+  // Check for initBus() called
+  if (_protocol == nullptr)
+  {
+    throw std::logic_error("BaseManager protocol not initialized");
+  }
+  // Baudrate Register of present Devices
+  // grouped by address
+  unsigned long current = _paramBusBaudrate.value;
+  std::map<addr_t, std::vector<Device*>> groups;
+  for (auto& dev : _devicesById)
+  {
+    if (!dev.second->isPresent())
+    {
+      continue;
+    }
+    addr_t addr;
+    data_t code;
+    if (!dev.second->baudrateCode(current, addr, code))
+    {
+      throw std::logic_error("BaseManager baudrate negotiation not supported by device id: " +
+                             std::to_string(dev.first));
+    }
+    groups[addr].push_back(dev.second);
+  }
+  if (groups.size() == 0)
+  {
+    return current;
+  }
+  // Return true if all Devices
+  // support given baudrate
+  auto isSupported = [&groups](unsigned long baudrate) -> bool {
+    for (const auto& group : groups)
+    {
+      for (Device* dev : group.second)
+      {
+        addr_t addr;
+        data_t code;
+        if (!dev->baudrateCode(baudrate, addr, code))
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  };
+  // Write all Devices baudrate Registers (given
+  // number of times) for given baudrate and switch the bus.
+  // The serial port is reconfigured in place so that
+  // Protocol Parameters and bus capture are kept.
+  auto switchBaudrate = [this, &groups](unsigned long baudrate, unsigned int repeat) {
+    {
+      std::lock_guard<std::mutex> lockBus(_mutexBus);
+      for (unsigned int k = 0; k < repeat; k++)
+      {
+        for (const auto& group : groups)
+        {
+          std::vector<id_t> ids;
+          std::vector<data_t> codes(group.second.size());
+          std::vector<const data_t*> datas;
+          for (size_t i = 0; i < group.second.size(); i++)
+          {
+            addr_t addr;
+            group.second[i]->baudrateCode(baudrate, addr, codes[i]);
+            ids.push_back(group.second[i]->id());
+            datas.push_back(&codes[i]);
+          }
+          _protocol->syncWrite(ids, group.first, datas, 1);
+          _stats.syncWriteCount++;
+          _stats.syncWriteLength += 1;
+        }
+      }
+    }
+    // Wait for EEPROM write (bus released
+    // for a possible emergency stop)
+    _clock.load()->sleepFor(std::chrono::milliseconds(SlowRegisterDelayMs));
+    std::lock_guard<std::mutex> lockBus(_mutexBus);
+    _paramBusBaudrate.value = baudrate;
+    if (_bus != nullptr)
+    {
+      _bus->setBaudrate(baudrate);
+    }
+    applyLinkTiming();
+  };
+  // Read back the baudrate Registers
+  // given number of times and return
+  // the number of errors
+  auto countErrors = [this, &groups, burst, report](unsigned long baudrate) -> unsigned long {
+    std::lock_guard<std::mutex> lockBus(_mutexBus);
+    unsigned long errors = 0;
+    for (unsigned int k = 0; k < burst; k++)
+    {
+      for (const auto& group : groups)
+      {
+        std::vector<id_t> ids;
+        std::vector<data_t> expected(group.second.size());
+        std::vector<data_t> values(group.second.size(), 0);
+        std::vector<data_t*> datas;
+        for (size_t i = 0; i < group.second.size(); i++)
+        {
+          addr_t addr;
+          group.second[i]->baudrateCode(baudrate, addr, expected[i]);
+          ids.push_back(group.second[i]->id());
+          datas.push_back(&values[i]);
+        }
+        std::vector<ResponseState> states;
+        if (_paramEnableSyncRead.value)
+        {
+          states = _protocol->syncRead(ids, group.first, datas, 1);
+          _stats.syncReadCount++;
+          _stats.syncReadLength += 1;
+        }
+        else
+        {
+          for (size_t i = 0; i < ids.size(); i++)
+          {
+            states.push_back(_protocol->readData(ids[i], group.first, datas[i], 1));
+            _stats.readCount++;
+            _stats.readLength += 1;
+          }
+        }
+        for (size_t i = 0; i < ids.size(); i++)
+        {
+          if (i >= states.size() || !(states[i] & ResponseOK) || values[i] != expected[i])
+          {
+            errors++;
+          }
+        }
+      }
+    }
+    if (report != nullptr)
+    {
+      report->push_back(std::make_pair(baudrate, errors));
+    }
+    return errors;
+  };
+
+  // Check the current baudrate
+  unsigned long selected = current;
+  unsigned long errors = countErrors(current);
+  if (errors > 0)
+  {
+    return current;
+  }
+  // Step through faster baudrates
+  for (unsigned long baudrate : baudrates)
+  {
+    if (baudrate <= selected || !isSupported(baudrate))
+    {
+      continue;
+    }
+    switchBaudrate(baudrate, 1);
+    errors = countErrors(baudrate);
+    if (errors == 0)
+    {
+      selected = baudrate;
+    }
+    else
+    {
+      // Switch back to the last reliable baudrate
+      // (repeated since the link is unreliable) and stop
+      switchBaudrate(selected, 3);
+      countErrors(selected);
+      break;
+    }
+  }
+
+  return selected;
 }
 
 void BaseManager::onNewRegister(id_t id, const std::string& name)
@@ -666,12 +1218,14 @@ void BaseManager::forceRegisterRead(id_t id, const std::string& name)
   unsigned int nbFails = 0;
   while (true)
   {
-    TimePoint pStart = getTimePoint();
+    TimePoint pStart = _clock.load()->now();
     ResponseState state = _protocol->readData(reg->id, reg->addr, reg->_dataBufferRead, reg->length);
-    TimePoint pStop = getTimePoint();
+    TimePoint pStop = _clock.load()->now();
     _stats.readCount++;
     _stats.readLength += reg->length;
     TimeDurationMicro duration = getTimeDuration<TimeDurationMicro>(pStart, pStop);
+    _recorder.append(FlightRecordForced, _readCycleCount, reg->id, reg->addr, reg->_dataBufferRead, reg->length,
+                     state, pStop, duration);
     _stats.sumReadDuration += duration;
     if (_stats.maxReadDuration < duration)
     {
@@ -687,6 +1241,11 @@ void BaseManager::forceRegisterRead(id_t id, const std::string& name)
     {
       // Error case
       reg->readError();
+      // Give up immediately on emergency stop
+      if (state & ResponseAborted)
+      {
+        return;
+      }
       nbFails++;
       if (nbFails >= MaxForceReTries)
       {
@@ -705,7 +1264,7 @@ void BaseManager::forceRegisterRead(id_t id, const std::string& name)
     }
   }
   // Retrieve the read timestamp
-  TimePoint timestamp = getTimePoint();
+  TimePoint timestamp = _clock.load()->now();
   // Set swapping flags and set timestamp
   reg->finishRead(timestamp);
   // Do swapping
@@ -731,16 +1290,23 @@ void BaseManager::forceRegisterWrite(id_t id, const std::string& name)
   bool isContinue = true;
   while (isContinue)
   {
-    TimePoint pStart = getTimePoint();
+    TimePoint pStart = _clock.load()->now();
+    ResponseState state = 0;
     if (_paramWaitWriteCheckResponse.value)
     {
       // Write and check response state
-      ResponseState state = _protocol->writeAndCheckData(reg->id, reg->addr, reg->_dataBufferWrite, reg->length);
+      state = _protocol->writeAndCheckData(reg->id, reg->addr, reg->_dataBufferWrite, reg->length);
       // Check for communication error
       if (checkResponseState(state, &(devById(id))))
       {
         isContinue = false;
       }
+      else if (state & ResponseAborted)
+      {
+        // Give up immediately on emergency stop
+        reg->writeError();
+        return;
+      }
       else
       {
         // If error, retries until max limit is reached.
@@ -769,10 +1335,12 @@ void BaseManager::forceRegisterWrite(id_t id, const std::string& name)
       _protocol->writeData(reg->id, reg->addr, reg->_dataBufferWrite, reg->length);
       isContinue = false;
     }
-    TimePoint pStop = getTimePoint();
+    TimePoint pStop = _clock.load()->now();
     _stats.writeCount++;
     _stats.writeLength += reg->length;
     TimeDurationMicro duration = getTimeDuration<TimeDurationMicro>(pStart, pStop);
+    _recorder.append(FlightRecordWrite | FlightRecordForced, _readCycleCount, reg->id, reg->addr,
+                     reg->_dataBufferWrite, reg->length, state, pStop, duration);
     _stats.sumWriteDuration += duration;
     if (_stats.maxWriteDuration < duration)
     {
@@ -782,7 +1350,7 @@ void BaseManager::forceRegisterWrite(id_t id, const std::string& name)
   // Wait delay in case of slow register
   if (reg->isSlowRegister)
   {
-    std::this_thread::sleep_for(std::chrono::milliseconds(SlowRegisterDelayMs));
+    _clock.load()->sleepFor(std::chrono::milliseconds(SlowRegisterDelayMs));
   }
 }
 
@@ -798,6 +1366,17 @@ void BaseManager::resetStatistics()
   _stats.reset();
 }
 
+std::shared_ptr<const Snapshot> BaseManager::snapshot() const
+{
+  return std::atomic_load(&_snapshot);
+}
+
+void BaseManager::setCallbackDeviceAdded(std::function<void(Device*)> func)
+{
+  std::lock_guard<std::mutex> lock(CallManager::_mutex);
+  _callbackDeviceAdded = func;
+}
+
 const ParametersList& BaseManager::parametersList() const
 {
   return _parametersList;
@@ -836,6 +1415,32 @@ void BaseManager::setProtocolConfig(const std::string& port, unsigned long baudr
   initBus();
 }
 
+void BaseManager::setBusCapture(const std::string& path)
+{
+  std::lock_guard<std::mutex> lock(CallManager::_mutex);
+  _paramBusCapture.value = path;
+  // Reset low level communication (bus/protocol)
+  initBus();
+}
+
+void BaseManager::setClock(Clock* clock)
+{
+  std::lock_guard<std::mutex> lock(CallManager::_mutex);
+  std::lock_guard<std::mutex> lockBus(_mutexBus);
+  if (clock == nullptr)
+  {
+    _clock = &defaultClock();
+  }
+  else
+  {
+    _clock = clock;
+  }
+  if (_protocol != nullptr)
+  {
+    _protocol->setClock(_clock);
+  }
+}
+
 void BaseManager::setEnableSyncRead(bool isEnable)
 {
   std::lock_guard<std::mutex> lock(CallManager::_mutex);
@@ -849,8 +1454,32 @@ void BaseManager::setEnableSyncWrite(bool isEnable)
 void BaseManager::setWaitWriteCheckResponse(bool isEnable)
 {
   std::lock_guard<std::mutex> lock(CallManager::_mutex);
+  if (_paramWaitWriteCheckResponse.value == isEnable)
+  {
+    return;
+  }
+  // Write status packets have to be enabled on
+  // Devices before writes are checked
+  _paramWaitWriteCheckResponse.value = false;
+  if (_paramOptimizeLink.value && _protocol != nullptr)
+  {
+    syncDevicesConfig(true, isEnable);
+  }
   _paramWaitWriteCheckResponse.value = isEnable;
 }
+void BaseManager::setOptimizeLink(bool isEnable)
+{
+  std::lock_guard<std::mutex> lock(CallManager::_mutex);
+  if (_paramOptimizeLink.value == isEnable)
+  {
+    return;
+  }
+  _paramOptimizeLink.value = isEnable;
+  if (_protocol != nullptr)
+  {
+    syncDevicesConfig(true, _paramWaitWriteCheckResponse.value);
+  }
+}
 void BaseManager::setThrowOnScan(bool isEnable)
 {
   std::lock_guard<std::mutex> lock(CallManager::_mutex);
@@ -862,6 +1491,136 @@ void BaseManager::setThrowOnRead(bool isEnable)
   _paramThrowErrorOnRead.value = isEnable;
 }
 
+void BaseManager::setCallbackExecutor(unsigned int threads, bool isCoalescing)
+{
+  {
+    std::lock_guard<std::mutex> lock(CallManager::_mutex);
+    _paramCallbackThreads.value = threads;
+    _paramCallbackCoalescing.value = isCoalescing;
+  }
+  initCallbackExecutor();
+}
+
+void BaseManager::initCallbackExecutor()
+{
+  unsigned int threads = 0;
+  bool isCoalescing;
+  {
+    std::lock_guard<std::mutex> lock(CallManager::_mutex);
+    if (_paramCallbackThreads.value > 0)
+    {
+      threads = (unsigned int)_paramCallbackThreads.value;
+    }
+    isCoalescing = _paramCallbackCoalescing.value;
+    // No task is pushed from now on
+    _callbackExecutor.disable();
+  }
+  // Workers callbacks may lock the
+  // Manager, they are joined unlocked
+  _callbackExecutor.start(threads, isCoalescing);
+}
+
+void BaseManager::setFlightRecorder(const std::string& path, unsigned long capacity)
+{
+  std::lock_guard<std::mutex> lock(CallManager::_mutex);
+  _paramRecorderPath.value = path;
+  _paramRecorderCapacity.value = capacity;
+  initFlightRecorder();
+}
+
+void BaseManager::initFlightRecorder()
+{
+  std::lock_guard<std::mutex> lockBus(_mutexBus);
+  _recorder.close();
+  if (_paramRecorderPath.value != "")
+  {
+    if (_paramRecorderCapacity.value < 1)
+    {
+      throw std::logic_error("BaseManager invalid recorder capacity");
+    }
+    _recorder.open(_paramRecorderPath.value, (size_t)_paramRecorderCapacity.value, _clock.load()->now());
+  }
+}
+
+/**
+ * Return true if given json
+ * holds a new value for given Parameter
+ */
+static bool isChangedJSON(const Json::Value& j, const ParameterBool& param)
+{
+  return j.isMember(param.name) && j[param.name].asBool() != param.value;
+}
+static bool isChangedJSON(const Json::Value& j, const ParameterNumber& param)
+{
+  return j.isMember(param.name) && j[param.name].asDouble() != param.value;
+}
+static bool isChangedJSON(const Json::Value& j, const ParameterStr& param)
+{
+  return j.isMember(param.name) && j[param.name].asString() != param.value;
+}
+
+BaseManager::ParametersReload BaseManager::diffParametersJSON(const Json::Value& j) const
+{
+  _parametersList.checkJSON(j);
+  ParametersReload reload;
+  if (j.isNull())
+  {
+    reload.isBusReset = false;
+    reload.isLinkSync = false;
+    reload.isExecutorReset = false;
+    reload.isRecorderReset = false;
+    return reload;
+  }
+  reload.isBusReset = isChangedJSON(j, _paramBusPort) || isChangedJSON(j, _paramBusBaudrate) ||
+                      isChangedJSON(j, _paramProtocolName) || isChangedJSON(j, _paramBusCapture);
+  // Write status packets are only
+  // configured with link optimization
+  bool isOptimizeLink =
+      j.isMember(_paramOptimizeLink.name) ? j[_paramOptimizeLink.name].asBool() : _paramOptimizeLink.value;
+  reload.isLinkSync = isChangedJSON(j, _paramOptimizeLink) ||
+                      (isOptimizeLink && isChangedJSON(j, _paramWaitWriteCheckResponse));
+  reload.isExecutorReset = isChangedJSON(j, _paramCallbackThreads) || isChangedJSON(j, _paramCallbackCoalescing);
+  reload.isRecorderReset =
+      reload.isBusReset || isChangedJSON(j, _paramRecorderPath) || isChangedJSON(j, _paramRecorderCapacity);
+
+  return reload;
+}
+
+bool BaseManager::reloadParametersJSON(const Json::Value& jManager, const Json::Value& jProtocol,
+                                       const ParametersReload& reload)
+{
+  // Load new configuration
+  _parametersList.loadJSON(jManager);
+  // Reset only changed subsystems
+  bool isBusReset = reload.isBusReset || _protocol == nullptr;
+  if (isBusReset)
+  {
+    initBus();
+  }
+  // Load specific Protocol parameters
+  // (in place if not reset)
+  {
+    std::lock_guard<std::mutex> lockBus(_mutexBus);
+    _protocol->parametersList().loadJSON(jProtocol);
+  }
+  // Resync the Devices link configuration
+  // (write status packets are enabled
+  // before writes are checked)
+  if (reload.isLinkSync)
+  {
+    bool isWriteStatus = _paramWaitWriteCheckResponse.value;
+    _paramWaitWriteCheckResponse.value = false;
+    syncDevicesConfig(true, isWriteStatus);
+    _paramWaitWriteCheckResponse.value = isWriteStatus;
+  }
+  if (reload.isRecorderReset || isBusReset)
+  {
+    initFlightRecorder();
+  }
+
+  return isBusReset;
+}
+
 void BaseManager::initBus()
 {
   std::lock_guard<std::mutex> lockBus(_mutexBus);
@@ -871,6 +1630,11 @@ void BaseManager::initBus()
     delete _protocol;
     _protocol = nullptr;
   }
+  if (_captureBus != nullptr)
+  {
+    delete _captureBus;
+    _captureBus = nullptr;
+  }
   if (_bus != nullptr)
   {
     delete _bus;
@@ -889,12 +1653,45 @@ void BaseManager::initBus()
                                std::string(_paramBusPort.value) + std::string(" exception: ") + std::string(e.what()));
     }
   }
-  _protocol = ProtocolFactory(_paramProtocolName.value, *_bus);
+  // Optionally wrap the bus to capture its traffic
+  if (_bus != nullptr && _paramBusCapture.value != "")
+  {
+    _captureBus = new CaptureBus(*_bus);
+    _captureBus->start(_paramBusCapture.value);
+    _protocol = ProtocolFactory(_paramProtocolName.value, *_captureBus);
+  }
+  else
+  {
+    _protocol = ProtocolFactory(_paramProtocolName.value, *_bus);
+  }
   // Check that Protocol implementation name is valid
   if (_protocol == nullptr)
   {
     throw std::logic_error("BaseManager invalid protocol name: " + _paramProtocolName.value);
   }
+  // Bind the emergency channel
+  _protocol->setAbortFlag(&_isEmergencyPending);
+  // Share the Manager clock
+  _protocol->setClock(_clock);
+  // Bus timing for the wait after writes
+  applyLinkTiming();
+}
+
+void BaseManager::applyLinkTiming()
+{
+  if (_protocol == nullptr)
+  {
+    return;
+  }
+  bool isApplied = _paramOptimizeLink.value;
+  for (const auto& dev : _devicesById)
+  {
+    if (dev.second->isPresent() && _linkAppliedIds.count(dev.first) == 0)
+    {
+      isApplied = false;
+    }
+  }
+  _protocol->setLinkTiming(_paramBusBaudrate.value, isApplied);
 }
 
 bool BaseManager::isNeedRead(Register* reg)
@@ -1028,12 +1825,13 @@ void BaseManager::writeBatch(BatchedRegisters& batch)
   if (batch.ids.size() == 1)
   {
     // Write single register
-    TimePoint pStart = getTimePoint();
+    TimePoint pStart = _clock.load()->now();
+    ResponseState state = 0;
     if (_paramWaitWriteCheckResponse.value)
     {
       // Write and check response state
-      ResponseState state = _protocol->writeAndCheckData(batch.ids.front(), batch.addr,
-                                                         batch.regs.front().front()->_dataBufferWrite, batch.length);
+      state = _protocol->writeAndCheckData(batch.ids.front(), batch.addr, batch.regs.front().front()->_dataBufferWrite,
+                                           batch.length);
       // Check for communication error
       if (!checkResponseState(state, _devicesById.at(batch.ids.front())))
       {
@@ -1051,10 +1849,12 @@ void BaseManager::writeBatch(BatchedRegisters& batch)
       // Direct write no check case
       _protocol->writeData(batch.ids.front(), batch.addr, batch.regs.front().front()->_dataBufferWrite, batch.length);
     }
-    TimePoint pStop = getTimePoint();
+    TimePoint pStop = _clock.load()->now();
     _stats.writeCount++;
     _stats.writeLength += batch.length;
     TimeDurationMicro duration = getTimeDuration<TimeDurationMicro>(pStart, pStop);
+    _recorder.append(FlightRecordWrite, _readCycleCount, batch.ids.front(), batch.addr,
+                     batch.regs.front().front()->_dataBufferWrite, batch.length, state, pStop, duration);
     _stats.sumWriteDuration += duration;
     if (_stats.maxWriteDuration < duration)
     {
@@ -1069,11 +1869,12 @@ void BaseManager::writeBatch(BatchedRegisters& batch)
     {
       datas.push_back(batch.regs[i].front()->_dataBufferWrite);
     }
-    TimePoint pStart = getTimePoint();
+    TimePoint pStart = _clock.load()->now();
+    std::vector<ResponseState> states;
     if (_paramWaitWriteCheckResponse.value)
     {
       // Write and check response state
-      std::vector<ResponseState> states = _protocol->syncWriteAndCheck(batch.ids, batch.addr, datas, batch.length);
+      states = _protocol->syncWriteAndCheck(batch.ids, batch.addr, datas, batch.length);
       for (size_t i = 0; i < states.size(); i++)
       {
         // Check for communication error
@@ -1094,10 +1895,15 @@ void BaseManager::writeBatch(BatchedRegisters& batch)
       // Direct write no check case
       _protocol->syncWrite(batch.ids, batch.addr, datas, batch.length);
     }
-    TimePoint pStop = getTimePoint();
+    TimePoint pStop = _clock.load()->now();
     _stats.syncWriteCount++;
     _stats.syncWriteLength += batch.length;
     TimeDurationMicro duration = getTimeDuration<TimeDurationMicro>(pStart, pStop);
+    for (size_t i = 0; i < batch.ids.size(); i++)
+    {
+      _recorder.append(FlightRecordWrite | FlightRecordSync, _readCycleCount, batch.ids[i], batch.addr, datas[i],
+                       batch.length, (i < states.size() ? states[i] : 0), pStop, duration);
+    }
     _stats.sumSyncWriteDuration += duration;
     if (_stats.maxSyncWriteDuration < duration)
     {
@@ -1129,13 +1935,15 @@ void BaseManager::readBatch(BatchedRegisters& batch)
   if (batch.ids.size() == 1)
   {
     // Read single register
-    TimePoint pStart = getTimePoint();
+    TimePoint pStart = _clock.load()->now();
     ResponseState state =
         _protocol->readData(batch.ids.front(), batch.addr, batch.regs.front().front()->_dataBufferRead, batch.length);
-    TimePoint pStop = getTimePoint();
+    TimePoint pStop = _clock.load()->now();
     _stats.readCount++;
     _stats.readLength += batch.length;
     TimeDurationMicro duration = getTimeDuration<TimeDurationMicro>(pStart, pStop);
+    _recorder.append(0, _readCycleCount, batch.ids.front(), batch.addr, batch.regs.front().front()->_dataBufferRead,
+                     batch.length, state, pStop, duration);
     _stats.sumReadDuration += duration;
     if (_stats.maxReadDuration < duration)
     {
@@ -1155,7 +1963,7 @@ void BaseManager::readBatch(BatchedRegisters& batch)
     {
       // Valid case
       // Retrieve the read timestamp
-      TimePoint timestamp = getTimePoint();
+      TimePoint timestamp = _clock.load()->now();
       // Assign timestamp on Manager side and
       // mark for swapping
       for (size_t j = 0; j < batch.regs.front().size(); j++)
@@ -1172,19 +1980,24 @@ void BaseManager::readBatch(BatchedRegisters& batch)
     {
       datas.push_back(batch.regs[i].front()->_dataBufferRead);
     }
-    TimePoint pStart = getTimePoint();
+    TimePoint pStart = _clock.load()->now();
     std::vector<ResponseState> states = _protocol->syncRead(batch.ids, batch.addr, datas, batch.length);
-    TimePoint pStop = getTimePoint();
+    TimePoint pStop = _clock.load()->now();
     _stats.syncReadCount++;
     _stats.syncReadLength += batch.length;
     TimeDurationMicro duration = getTimeDuration<TimeDurationMicro>(pStart, pStop);
+    for (size_t i = 0; i < states.size(); i++)
+    {
+      _recorder.append(FlightRecordSync, _readCycleCount, batch.ids[i], batch.addr, datas[i], batch.length, states[i],
+                       pStop, duration);
+    }
     _stats.sumSyncReadDuration += duration;
     if (_stats.maxSyncReadDuration < duration)
     {
       _stats.maxSyncReadDuration = duration;
     }
     // Retrieve the read timestamp
-    TimePoint timestamp = getTimePoint();
+    TimePoint timestamp = _clock.load()->now();
     for (size_t i = 0; i < states.size(); i++)
     {
       // Check for communication error
@@ -1217,6 +2030,34 @@ void BaseManager::swapRead()
   {
     _sortedRegisters[i]->swapRead();
   }
+  publishSnapshot();
+}
+
+void BaseManager::publishSnapshot()
+{
+  // Reuse the previous buffer if no reader
+  // still holds it (it is no longer published so
+  // no new reader can acquire it)
+  std::shared_ptr<Snapshot> snap;
+  if (_snapshotSpare != nullptr && _snapshotSpare.use_count() == 1)
+  {
+    snap = std::move(_snapshotSpare);
+  }
+  else
+  {
+    snap = std::make_shared<Snapshot>();
+  }
+  std::shared_ptr<const Snapshot> last = std::atomic_load(&_snapshot);
+  snap->epoch = last->epoch + 1;
+  snap->timestamp = _clock.load()->now();
+  snap->entries.resize(_sortedRegisters.size());
+  for (size_t i = 0; i < _sortedRegisters.size(); i++)
+  {
+    _sortedRegisters[i]->snapshot(snap->entries[i]);
+  }
+  // Publish
+  last = std::atomic_exchange(&_snapshot, std::shared_ptr<const Snapshot>(snap));
+  _snapshotSpare = std::const_pointer_cast<Snapshot>(last);
 }
 
 void BaseManager::swapCallBack()
@@ -1227,8 +2068,20 @@ void BaseManager::swapCallBack()
   }
 }
 
+bool BaseManager::isEmergencyRequested(unsigned long epoch) const
+{
+  return _isEmergencyPending || _emergencyEpoch != epoch;
+}
+
 bool BaseManager::checkResponseState(ResponseState state, Device* dev)
 {
+  // An aborted transaction does not
+  // tell anything about the Device
+  if (state & ResponseAborted)
+  {
+    return false;
+  }
+
   // Check if the device has answered
   bool isPresent = true;
   if (state & ResponseQuiet)
@@ -1321,10 +2174,28 @@ bool BaseManager::retrieveTypeNumber(id_t id, type_t& type)
   }
   // Read at static memory address
   data_t* pt = reinterpret_cast<data_t*>(&type);
+  TimePoint pStart = _clock.load()->now();
   ResponseState state = _protocol->readData(id, AddrDevTypeNumber, pt, 2);
+  TimePoint pStop = _clock.load()->now();
+  _recorder.append(FlightRecordForced, _readCycleCount, id, AddrDevTypeNumber, pt, 2, state, pStop,
+                   getTimeDuration<TimeDurationMicro>(pStart, pStop));
 
   // Check response
   return checkResponseState(state, nullptr);
 }
 
+bool BaseManager::pingBus(id_t id)
+{
+  TimePoint pStart = _clock.load()->now();
+  bool response = _protocol->ping(id);
+  TimePoint pStop = _clock.load()->now();
+  // No data is exchanged, the answer
+  // is recorded in the response state
+  data_t dummy = 0;
+  _recorder.append(FlightRecordPing | FlightRecordForced, _readCycleCount, id, 0, &dummy, 0,
+                   response ? ResponseOK : ResponseQuiet, pStop, getTimeDuration<TimeDurationMicro>(pStart, pStop));
+
+  return response;
+}
+
 }  // namespace RhAL
@@ -7,16 +7,21 @@
 #include <json/json.h>
 #include <fstream>
 #include <mutex>
+#include <atomic>
 #include <thread>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <condition_variable>
 #include <exception>
 #include "Statistics.hpp"
+#include "Snapshot.hpp"
+#include "FlightRecorder.hpp"
 #include "Device.hpp"
 #include "CallManager.hpp"
 #include "Bus/SerialBus.hpp"
+#include "Bus/CaptureBus.hpp"
 #include "Protocol/Protocol.hpp"
 #include "Protocol/ProtocolFactory.hpp"
 
@@ -32,6 +37,12 @@ namespace RhAL
  */
 class BaseManager : public CallManager
 {
+  /**
+   * Bus benchmark accesses the
+   * Protocol and bus mutex
+   */
+  friend class Bench;
+
 public:
   /**
    * Typedef for device container
@@ -98,7 +109,12 @@ public:
 
   /**
    * Immediately sends a broadcasted signal
-   * to put all the devices in emergency mode
+   * to put all the devices in emergency mode.
+   * The Manager does not need to be idle: a
+   * running flush() gives up its current
+   * transaction at the next packet boundary
+   * and drops all its remaining batches.
+   * Can be called from any thread.
    */
   void emergencyStop();
 
@@ -140,6 +156,26 @@ public:
    */
   void flush(bool isForceSwap = true);
 
+  /**
+   * Return the number of completed flush()
+   * bus operations. Writes selected before a
+   * flush() starts are performed once it has
+   * been incremented.
+   */
+  unsigned long cycleCount() const;
+
+  /**
+   * Call given function with Registers
+   * selection locked so that all the Registers
+   * it writes are selected by the same flush()
+   * (and batched together in sync writes).
+   * The function must only write Registers
+   * and not call any Manager method.
+   * In immediate (not schedule) mode, the
+   * function is called without lock.
+   */
+  void atomicWrite(std::function<void()> func);
+
   /**
    * Force all Registers to swap in order to
    * apply immediately read values
@@ -185,10 +221,43 @@ public:
   bool checkDevices();
 
   /**
-   * Call setConfig on all registered Devices
-   * that are present.
-   */
-  void setDevicesConfig();
+   * Synchronize the configuration of all
+   * registered Devices that are present.
+   * Desired values from Device::getConfig() are
+   * read back from the hardware (grouped in
+   * sync reads), diffed and only the differing
+   * bytes are written (devices with the same
+   * differing range grouped in sync writes).
+   * Device setConfig() is also called and the
+   * Device link configuration (optimized or
+   * default, see optimizeLink) is also synchronized.
+   * Configuration writes are not checked since
+   * they may change Devices write status packets.
+   * Return the number of written Devices.
+   */
+  size_t setDevicesConfig();
+
+  /**
+   * Step all present Devices, starting from
+   * current bus baudrate, through given candidate
+   * baudrates (in BPS, increasing order) supported
+   * by all of them. At each step, the Devices
+   * baudrate Registers and the bus are switched and
+   * given number of sync reads are done. The fastest
+   * baudrate without any error is kept (Devices are
+   * switched back to it on first failure) and
+   * assigned to the bus baudrate Parameter.
+   * Only the serial port baudrate is changed, the
+   * Protocol (and its Parameters) and the bus
+   * capture are kept.
+   * If not null, each read back baudrate and its
+   * number of errors are appended to given report.
+   * The Manager thread has to be stopped.
+   * Return the selected baudrate.
+   */
+  unsigned long negotiateBaudrate(
+      const std::vector<unsigned long>& baudrates = { 1000000, 2000000, 2250000, 3000000, 4500000 },
+      unsigned int burst = 100, std::vector<std::pair<unsigned long, unsigned long>>* report = nullptr);
 
   /**
    * Inherit.
@@ -222,6 +291,23 @@ public:
    */
   void resetStatistics();
 
+  /**
+   * Return the last published whole robot
+   * Registers snapshot (never null).
+   * The snapshot is immutable and consistent as
+   * of one swap. Acquired with one atomic load,
+   * it stays valid as long as the returned
+   * pointer is held, without blocking the Manager.
+   */
+  std::shared_ptr<const Snapshot> snapshot() const;
+
+  /**
+   * Set the callback called after
+   * each new Device is added
+   * (devAdd(), scan(), configuration loading)
+   */
+  void setCallbackDeviceAdded(std::function<void(Device*)> func);
+
   /**
    * Read/Write access to Manager Parameters list
    */
@@ -242,14 +328,52 @@ public:
   void setProtocolConfig(const std::string& port, unsigned long baudrate, const std::string& protocol);
 
   /**
-   * Manager Parameters setters
+   * Enable the capture of all bytes sent
+   * and received on the serial bus into given
+   * pcap file. An empty path disables the capture.
+   * The Bus and Protocol are reset.
+   */
+  void setBusCapture(const std::string& path);
+
+  /**
+   * Set the clock used by the Manager, its
+   * Protocol and Devices (not owned, has to
+   * outlive the Manager). Null resets to the
+   * default real time clock.
+   * Has to be called before the Manager
+   * thread is started.
+   */
+  void setClock(Clock* clock);
+
+  /**
+   * Manager Parameters setters.
+   * Changing waitWriteCheckResponse (if optimizeLink
+   * is enabled) or optimizeLink resyncs the present
+   * Devices link configuration.
    */
   void setEnableSyncRead(bool isEnable);
   void setEnableSyncWrite(bool isEnable);
   void setWaitWriteCheckResponse(bool isEnable);
+  void setOptimizeLink(bool isEnable);
   void setThrowOnScan(bool isEnable);
   void setThrowOnRead(bool isEnable);
 
+  /**
+   * Set the number of threads running Registers
+   * read callbacks out of the Manager critical section
+   * (0: synchronous callbacks during swap) and if
+   * only the latest value of each Register is delivered
+   */
+  void setCallbackExecutor(unsigned int threads, bool isCoalescing);
+
+  /**
+   * Enable the flight recorder logging all bus
+   * transactions raw bytes into given file (ring
+   * buffer of given number of records).
+   * An empty path disables the recorder.
+   */
+  void setFlightRecorder(const std::string& path, unsigned long capacity);
+
   /**
    * The BaseManager has to call some
    * functions of AggregateManager
@@ -277,6 +401,12 @@ protected:
    */
   ParametersList _parametersList;
 
+  /**
+   * User callback called with
+   * each newly added Device
+   */
+  std::function<void(Device*)> _callbackDeviceAdded;
+
   /**
    * Reset and initialize the
    * Bus and Protocol instance.
@@ -285,6 +415,64 @@ protected:
    */
   void initBus();
 
+  /**
+   * Restart the callback executor with
+   * current parameters.
+   * (Must not be called under CallManager
+   * mutex since workers are joined)
+   */
+  void initCallbackExecutor();
+
+  /**
+   * Reopen or close the flight
+   * recorder with current parameters
+   */
+  void initFlightRecorder();
+
+  /**
+   * Subsystems to reset when
+   * reloading Manager Parameters
+   */
+  struct ParametersReload
+  {
+    // Bus and Protocol reopening
+    bool isBusReset;
+    // Devices link configuration sync
+    bool isLinkSync;
+    // Callback executor restart
+    bool isExecutorReset;
+    // Flight recorder reopening
+    bool isRecorderReset;
+  };
+
+  /**
+   * Check given Manager Parameters json
+   * and compare it with current Parameters to
+   * find the subsystems to reset (the Bus and
+   * Protocol are reopened only if port, baudrate,
+   * protocol or capture changed).
+   * Throw std::runtime_error if given
+   * json is malformated.
+   * (Called before locking, Manager Parameters
+   * are only assigned by the configuration thread)
+   */
+  ParametersReload diffParametersJSON(const Json::Value& j) const;
+
+  /**
+   * Load given Manager and Protocol Parameters
+   * json and only reset the subsystems flagged
+   * by diffParametersJSON(), except the callback
+   * executor which is restarted by the caller
+   * once unlocked. Other Parameters are
+   * applied in place. Protocol Parameters are
+   * loaded under the bus mutex.
+   * Return true if the Bus and Protocol
+   * have been reset.
+   * (Called under CallManager mutex)
+   */
+  bool reloadParametersJSON(const Json::Value& jManager, const Json::Value& jProtocol,
+                            const ParametersReload& reload);
+
 private:
   /**
    * Internal structure
@@ -312,6 +500,18 @@ private:
    */
   mutable std::mutex _mutexBus;
 
+  /**
+   * Emergency channel.
+   * EmergencyPending is raised while an
+   * emergencyStop() is waiting for the bus
+   * and is polled by the Protocol.
+   * EmergencyEpoch counts sent emergency
+   * broadcasts and is used by flush() to
+   * drop batches computed before the stop.
+   */
+  std::atomic<bool> _isEmergencyPending;
+  std::atomic<unsigned long> _emergencyEpoch;
+
   /**
    * Container of all Register pointers
    * sorted by their id and then by address
@@ -319,10 +519,25 @@ private:
    */
   std::vector<Register*> _sortedRegisters;
 
+  /**
+   * Last published Registers snapshot
+   * (atomically swapped) and recycled
+   * previous snapshot buffer (only reused
+   * once no reader holds it anymore)
+   */
+  std::shared_ptr<const Snapshot> _snapshot;
+  std::shared_ptr<Snapshot> _snapshotSpare;
+
+  /**
+   * Bus transactions binary log
+   * (protected by the bus mutex)
+   */
+  FlightRecorder _recorder;
+
   /**
    * Count all readFlush() calls
    */
-  unsigned long _readCycleCount;
+  std::atomic<unsigned long> _readCycleCount;
 
   /**
    * Condition variable for
@@ -371,9 +586,11 @@ private:
   Statistics _stats;
 
   /**
-   * Serial bus and Protocol pointers
+   * Serial bus, optional capture
+   * decorator and Protocol pointers
    */
   SerialBus* _bus;
+  CaptureBus* _captureBus;
   Protocol* _protocol;
 
   /**
@@ -387,6 +604,12 @@ private:
   ParameterNumber _paramBusBaudrate;
   ParameterStr _paramProtocolName;
 
+  /**
+   * Bus bytes capture pcap file
+   * path (empty: capture disabled)
+   */
+  ParameterStr _paramBusCapture;
+
   /**
    * Register Batching configuration.
    * EnableSyncRead: is protocol syncRead used.
@@ -404,6 +627,25 @@ private:
    */
   ParameterBool _paramWaitWriteCheckResponse;
 
+  /**
+   * Link latency optimization. If true,
+   * the configuration sync also sets the minimal
+   * Devices return delay and disables write status
+   * packets when write check is off, and the
+   * Protocol waits after writes for a computed
+   * guard time instead of its fixed delay (only
+   * once all present Devices are configured).
+   * If false, write status packets are restored.
+   */
+  ParameterBool _paramOptimizeLink;
+
+  /**
+   * Ids of Devices whose optimized link
+   * configuration has been applied
+   * (protected by the bus mutex)
+   */
+  std::set<id_t> _linkAppliedIds;
+
   /**
    * Exception error configuration.
    * If true, an std::runtime_error exception
@@ -416,6 +658,26 @@ private:
   ParameterBool _paramThrowErrorOnScan;
   ParameterBool _paramThrowErrorOnRead;
 
+  /**
+   * Read callbacks execution.
+   * CallbackThreads: number of executor threads
+   * (0: callbacks are called synchronously).
+   * CallbackCoalescing: only deliver the latest
+   * read value of each Register.
+   */
+  ParameterNumber _paramCallbackThreads;
+  ParameterBool _paramCallbackCoalescing;
+
+  /**
+   * Flight recorder.
+   * RecorderPath: binary log file path
+   * (empty: recorder disabled).
+   * RecorderCapacity: number of records
+   * kept in the ring buffer file.
+   */
+  ParameterStr _paramRecorderPath;
+  ParameterNumber _paramRecorderCapacity;
+
   /**
    * Return true if given Register pointer
    * is mark has to be read or write
@@ -440,6 +702,29 @@ private:
   void writeBatch(BatchedRegisters& batch);
   void readBatch(BatchedRegisters& batch);
 
+  /**
+   * Return true if an emergency stop is
+   * pending or has been sent since the given
+   * emergency epoch
+   */
+  bool isEmergencyRequested(unsigned long epoch) const;
+
+  /**
+   * Implement setDevicesConfig(). If isLinkOnly,
+   * only the Devices link configuration is synced
+   * for given write status packets state.
+   * Return the number of written Devices.
+   */
+  size_t syncDevicesConfig(bool isLinkOnly, bool isWriteStatus);
+
+  /**
+   * Set the Protocol link timing. The computed
+   * wait after write is only enabled if optimizeLink
+   * is set and applied on all present Devices.
+   * (Called under bus mutex)
+   */
+  void applyLinkTiming();
+
   /**
    * Iterate over all registers and
    * swap then to apply read change if
@@ -448,6 +733,13 @@ private:
    */
   void swapRead();
 
+  /**
+   * Build and publish a new Registers snapshot
+   * from current read values.
+   * (No thread protection)
+   */
+  void publishSnapshot();
+
   /**
    * Iterate over all Devices and
    * trigger Device onSwap() call back.
@@ -472,6 +764,13 @@ private:
    * (The bus access is supposed to be locked)
    */
   bool retrieveTypeNumber(id_t id, type_t& type);
+
+  /**
+   * Ping given id and record the
+   * transaction in the flight recorder.
+   * (The bus access is supposed to be locked)
+   */
+  bool pingBus(id_t id);
 };
 
 }  // namespace RhAL
@@ -0,0 +1,553 @@
+#include <algorithm>
+#include <limits>
+#include <iomanip>
+#include <mutex>
+#include <stdexcept>
+#include "Bench.hpp"
+#include "BaseManager.hpp"
+#include "Device.hpp"
+#include "timestamp.h"
+
+namespace RhAL
+{
+Bench::Timing::Timing() : count(0), errors(0), sum(0.0), min(std::numeric_limits<double>::max()), max(0.0)
+{
+}
+
+void Bench::Timing::add(double duration, bool isOK)
+{
+  count++;
+  if (!isOK)
+  {
+    errors++;
+  }
+  sum += duration;
+  min = std::min(min, duration);
+  max = std::max(max, duration);
+}
+
+Json::Value Bench::Timing::toJSON() const
+{
+  Json::Value j(Json::objectValue);
+  j["count"] = (Json::UInt64)count;
+  j["errors"] = (Json::UInt64)errors;
+  j["errorRate"] = (count > 0) ? (double)errors / count : 0.0;
+  // Durations in microseconds
+  j["meanUs"] = (count > 0) ? 1e6 * sum / count : 0.0;
+  j["minUs"] = (count > 0) ? 1e6 * min : 0.0;
+  j["maxUs"] = 1e6 * max;
+  return j;
+}
+
+Bench::Bench(BaseManager& manager, unsigned int iterations) : _manager(manager), _iterations(iterations)
+{
+  if (iterations == 0)
+  {
+    throw std::logic_error("Bench invalid iterations count");
+  }
+}
+
+Json::Value Bench::run()
+{
+  Json::Value j(Json::objectValue);
+  j["port"] = _manager._paramBusPort.value;
+  j["baudrate"] = (Json::UInt64)_manager._paramBusBaudrate.value;
+  j["protocol"] = _manager._paramProtocolName.value;
+  j["iterations"] = _iterations;
+  j["devices"] = (Json::UInt64)presentDevices().size();
+  j["ping"] = benchPing();
+  j["read"] = benchRead();
+  j["write"] = benchWrite();
+  j["syncRead"] = benchSyncRead();
+  j["syncWrite"] = benchSyncWrite();
+  j["flush"] = benchFlush();
+  // Total error rate over
+  // all bus transactions
+  unsigned long count = 0;
+  unsigned long errors = 0;
+  for (const char* name : { "ping", "read", "write", "syncRead", "syncWrite" })
+  {
+    for (const Json::Value& entry : j[name])
+    {
+      // Failed write pre-reads are
+      // counted apart from timings
+      count += entry["count"].asUInt64() + entry.get("readErrors", 0).asUInt64();
+      errors += entry["errors"].asUInt64() + entry.get("readErrors", 0).asUInt64();
+    }
+  }
+  j["errors"]["count"] = (Json::UInt64)count;
+  j["errors"]["errors"] = (Json::UInt64)errors;
+  j["errors"]["errorRate"] = (count > 0) ? (double)errors / count : 0.0;
+  return j;
+}
+
+Json::Value Bench::benchPing()
+{
+  std::lock_guard<std::mutex> lock(_manager.CallManager::_mutex);
+  if (_manager._protocol == nullptr)
+  {
+    throw std::logic_error("Bench protocol not initialized");
+  }
+  std::lock_guard<std::mutex> lockBus(_manager._mutexBus);
+  Json::Value j(Json::arrayValue);
+  for (Device* dev : presentDevices())
+  {
+    Timing timing;
+    for (unsigned int k = 0; k < _iterations; k++)
+    {
+      TimePoint start = getTimePoint();
+      bool isOK = _manager._protocol->ping(dev->id());
+      timing.add(duration_float(start, getTimePoint()), isOK);
+    }
+    Json::Value entry = timing.toJSON();
+    entry["id"] = dev->id();
+    entry["name"] = dev->name();
+    j.append(entry);
+  }
+  return j;
+}
+
+Json::Value Bench::benchRead(const std::vector<size_t>& sizes)
+{
+  std::lock_guard<std::mutex> lock(_manager.CallManager::_mutex);
+  if (_manager._protocol == nullptr)
+  {
+    throw std::logic_error("Bench protocol not initialized");
+  }
+  std::lock_guard<std::mutex> lockBus(_manager._mutexBus);
+  std::vector<Device*> devs = presentDevices();
+  Json::Value j(Json::arrayValue);
+  if (devs.size() == 0)
+  {
+    return j;
+  }
+  data_t buffer[AddrDevLen];
+  for (size_t size : sizes)
+  {
+    if (size == 0 || size > AddrDevLen)
+    {
+      continue;
+    }
+    // Devices are read in turn
+    // from the table beginning
+    Timing timing;
+    for (unsigned int k = 0; k < _iterations; k++)
+    {
+      Device* dev = devs[k % devs.size()];
+      TimePoint start = getTimePoint();
+      ResponseState state = _manager._protocol->readData(dev->id(), 0, buffer, size);
+      timing.add(duration_float(start, getTimePoint()), state & ResponseOK);
+    }
+    Json::Value entry = timing.toJSON();
+    entry["size"] = (Json::UInt64)size;
+    entry["bytesPerSec"] = (timing.sum > 0.0) ? (timing.count - timing.errors) * size / timing.sum : 0.0;
+    j.append(entry);
+  }
+  return j;
+}
+
+Json::Value Bench::benchWrite(const std::vector<size_t>& sizes)
+{
+  std::lock_guard<std::mutex> lock(_manager.CallManager::_mutex);
+  if (_manager._protocol == nullptr)
+  {
+    throw std::logic_error("Bench protocol not initialized");
+  }
+  std::lock_guard<std::mutex> lockBus(_manager._mutexBus);
+  // Writable range of each Device and
+  // whether it answers to writes (no status
+  // packet once the link is optimized
+  // without write check)
+  struct Range
+  {
+    Device* dev;
+    addr_t addr;
+    size_t length;
+    bool isChecked;
+  };
+  bool isNoWriteStatus = _manager._paramOptimizeLink.value && !_manager._paramWaitWriteCheckResponse.value;
+  std::vector<Range> ranges;
+  for (Device* dev : presentDevices())
+  {
+    Range range;
+    range.dev = dev;
+    range.isChecked = !isNoWriteStatus || _manager._linkAppliedIds.count(dev->id()) == 0;
+    if (writableRange(dev, range.addr, range.length))
+    {
+      ranges.push_back(range);
+    }
+  }
+  Json::Value j(Json::arrayValue);
+  data_t buffer[AddrDevLen];
+  for (size_t size : sizes)
+  {
+    std::vector<const Range*> selected;
+    for (const Range& range : ranges)
+    {
+      if (size > 0 && size <= range.length)
+      {
+        selected.push_back(&range);
+      }
+    }
+    if (selected.size() == 0)
+    {
+      continue;
+    }
+    // The current memory is read and written
+    // back (only the write round trip is timed)
+    Timing timing;
+    unsigned long readErrors = 0;
+    unsigned long unchecked = 0;
+    for (unsigned int k = 0; k < _iterations; k++)
+    {
+      const Range& range = *selected[k % selected.size()];
+      ResponseState state = _manager._protocol->readData(range.dev->id(), range.addr, buffer, size);
+      if (!(state & ResponseOK))
+      {
+        readErrors++;
+        continue;
+      }
+      TimePoint start = getTimePoint();
+      if (range.isChecked)
+      {
+        state = _manager._protocol->writeAndCheckData(range.dev->id(), range.addr, buffer, size);
+      }
+      else
+      {
+        // The Protocol wait after
+        // write is included
+        _manager._protocol->writeData(range.dev->id(), range.addr, buffer, size);
+        state = ResponseOK;
+        unchecked++;
+      }
+      timing.add(duration_float(start, getTimePoint()), state & ResponseOK);
+    }
+    Json::Value entry = timing.toJSON();
+    entry["size"] = (Json::UInt64)size;
+    entry["readErrors"] = (Json::UInt64)readErrors;
+    entry["unchecked"] = (Json::UInt64)unchecked;
+    entry["bytesPerSec"] = (timing.sum > 0.0) ? (timing.count - timing.errors) * size / timing.sum : 0.0;
+    j.append(entry);
+  }
+  return j;
+}
+
+Json::Value Bench::benchSyncRead(size_t size)
+{
+  std::lock_guard<std::mutex> lock(_manager.CallManager::_mutex);
+  if (_manager._protocol == nullptr)
+  {
+    throw std::logic_error("Bench protocol not initialized");
+  }
+  Json::Value j(Json::arrayValue);
+  if (!_manager._paramEnableSyncRead.value || size == 0 || size > AddrDevLen)
+  {
+    return j;
+  }
+  std::lock_guard<std::mutex> lockBus(_manager._mutexBus);
+  std::vector<Device*> devs = presentDevices();
+  std::vector<std::vector<data_t>> buffers(devs.size(), std::vector<data_t>(size));
+  for (size_t n : deviceCounts(devs.size()))
+  {
+    std::vector<id_t> ids;
+    std::vector<data_t*> datas;
+    for (size_t i = 0; i < n; i++)
+    {
+      ids.push_back(devs[i]->id());
+      datas.push_back(buffers[i].data());
+    }
+    // A transaction is in error if
+    // any Device response is missing
+    Timing timing;
+    unsigned long responses = 0;
+    for (unsigned int k = 0; k < _iterations; k++)
+    {
+      TimePoint start = getTimePoint();
+      std::vector<ResponseState> states = _manager._protocol->syncRead(ids, 0, datas, size);
+      double duration = duration_float(start, getTimePoint());
+      size_t countOK = 0;
+      for (ResponseState state : states)
+      {
+        if (state & ResponseOK)
+        {
+          countOK++;
+        }
+      }
+      responses += countOK;
+      timing.add(duration, countOK == n);
+    }
+    Json::Value entry = timing.toJSON();
+    entry["devices"] = (Json::UInt64)n;
+    entry["size"] = (Json::UInt64)size;
+    entry["bytesPerSec"] = (timing.sum > 0.0) ? responses * size / timing.sum : 0.0;
+    entry["transactionsPerSec"] = (timing.sum > 0.0) ? timing.count / timing.sum : 0.0;
+    j.append(entry);
+  }
+  return j;
+}
+
+Json::Value Bench::benchSyncWrite(size_t size)
+{
+  std::lock_guard<std::mutex> lock(_manager.CallManager::_mutex);
+  if (_manager._protocol == nullptr)
+  {
+    throw std::logic_error("Bench protocol not initialized");
+  }
+  Json::Value j(Json::arrayValue);
+  if (!_manager._paramEnableSyncWrite.value || size == 0 || size > AddrDevLen)
+  {
+    return j;
+  }
+  std::lock_guard<std::mutex> lockBus(_manager._mutexBus);
+  // Select Devices whose writable range
+  // covers the first Device one
+  std::vector<Device*> devs;
+  addr_t addr = 0;
+  for (Device* dev : presentDevices())
+  {
+    addr_t devAddr;
+    size_t devLength;
+    if (!writableRange(dev, devAddr, devLength))
+    {
+      continue;
+    }
+    if (devs.size() == 0)
+    {
+      if (devLength < size)
+      {
+        continue;
+      }
+      addr = devAddr;
+    }
+    if (addr >= devAddr && addr + size <= devAddr + devLength)
+    {
+      devs.push_back(dev);
+    }
+  }
+  // Current memory to be written back
+  std::vector<std::vector<data_t>> buffers(devs.size(), std::vector<data_t>(size));
+  std::vector<Device*> devsRead;
+  for (size_t i = 0; i < devs.size(); i++)
+  {
+    ResponseState state = _manager._protocol->readData(devs[i]->id(), addr, buffers[devsRead.size()].data(), size);
+    if (state & ResponseOK)
+    {
+      devsRead.push_back(devs[i]);
+    }
+  }
+  for (size_t n : deviceCounts(devsRead.size()))
+  {
+    std::vector<id_t> ids;
+    std::vector<const data_t*> datas;
+    for (size_t i = 0; i < n; i++)
+    {
+      ids.push_back(devsRead[i]->id());
+      datas.push_back(buffers[i].data());
+    }
+    // Sync write has no response, the
+    // Protocol wait after write is included
+    Timing timing;
+    for (unsigned int k = 0; k < _iterations; k++)
+    {
+      TimePoint start = getTimePoint();
+      _manager._protocol->syncWrite(ids, addr, datas, size);
+      timing.add(duration_float(start, getTimePoint()), true);
+    }
+    Json::Value entry = timing.toJSON();
+    entry["devices"] = (Json::UInt64)n;
+    entry["size"] = (Json::UInt64)size;
+    entry["addr"] = addr;
+    entry["bytesPerSec"] = (timing.sum > 0.0) ? timing.count * n * size / timing.sum : 0.0;
+    entry["transactionsPerSec"] = (timing.sum > 0.0) ? timing.count / timing.sum : 0.0;
+    j.append(entry);
+  }
+  return j;
+}
+
+Json::Value Bench::benchFlush()
+{
+  Json::Value j(Json::objectValue);
+  if (!_manager.isScheduleMode())
+  {
+    return j;
+  }
+  // Warm up (first flush reads
+  // all Registers and writes
+  // pending values)
+  _manager.flush();
+  Statistics before = _manager.getStatistics();
+  Timing timing;
+  for (unsigned int k = 0; k < _iterations; k++)
+  {
+    TimePoint start = getTimePoint();
+    _manager.flush();
+    timing.add(duration_float(start, getTimePoint()), true);
+  }
+  Statistics after = _manager.getStatistics();
+  j = timing.toJSON();
+  j["rateHz"] = (timing.sum > 0.0) ? timing.count / timing.sum : 0.0;
+  j["readCount"] = (Json::UInt64)(after.readCount - before.readCount);
+  j["syncReadCount"] = (Json::UInt64)(after.syncReadCount - before.syncReadCount);
+  j["writeCount"] = (Json::UInt64)(after.writeCount - before.writeCount);
+  j["syncWriteCount"] = (Json::UInt64)(after.syncWriteCount - before.syncWriteCount);
+  j["writeErrorCount"] = (Json::UInt64)(after.writeErrorCount - before.writeErrorCount);
+  j["deviceErrorCount"] = (Json::UInt64)(after.deviceErrorCount - before.deviceErrorCount);
+  j["deviceWarningCount"] = (Json::UInt64)(after.deviceWarningCount - before.deviceWarningCount);
+  return j;
+}
+
+void Bench::printTable(std::ostream& os, const Json::Value& results)
+{
+  // Print one table row of
+  // timing columns
+  auto printTiming = [&os](const Json::Value& entry) {
+    os << std::setw(8) << entry["count"].asUInt64() << std::setw(8) << entry["errors"].asUInt64() << std::setw(10)
+       << std::fixed << std::setprecision(1) << entry["meanUs"].asDouble() << std::setw(10)
+       << entry["minUs"].asDouble() << std::setw(10) << entry["maxUs"].asDouble();
+  };
+  auto printHeader = [&os](const std::string& title, const std::string& first, const std::string& last) {
+    os << std::endl << title << std::endl;
+    os << std::setw(12) << first << std::setw(8) << "count" << std::setw(8) << "errors" << std::setw(10) << "mean(us)"
+       << std::setw(10) << "min(us)" << std::setw(10) << "max(us)" << std::setw(14) << last << std::endl;
+  };
+
+  os << "Bench port=" << results["port"].asString() << " baudrate=" << results["baudrate"].asUInt64()
+     << " protocol=" << results["protocol"].asString() << " devices=" << results["devices"].asUInt64()
+     << " iterations=" << results["iterations"].asUInt() << std::endl;
+
+  printHeader("Ping latency", "id", "name");
+  for (const Json::Value& entry : results["ping"])
+  {
+    os << std::setw(12) << entry["id"].asUInt();
+    printTiming(entry);
+    os << std::setw(14) << entry["name"].asString() << std::endl;
+  }
+  printHeader("Read round trip", "size", "bytes/s");
+  for (const Json::Value& entry : results["read"])
+  {
+    os << std::setw(12) << entry["size"].asUInt64();
+    printTiming(entry);
+    os << std::setw(14) << std::setprecision(0) << entry["bytesPerSec"].asDouble() << std::endl;
+  }
+  printHeader("Write round trip", "size", "bytes/s");
+  for (const Json::Value& entry : results["write"])
+  {
+    os << std::setw(12) << entry["size"].asUInt64();
+    printTiming(entry);
+    os << std::setw(14) << std::setprecision(0) << entry["bytesPerSec"].asDouble();
+    if (entry["readErrors"].asUInt64() > 0)
+    {
+      os << " (" << entry["readErrors"].asUInt64() << " failed pre-reads)";
+    }
+    if (entry["unchecked"].asUInt64() > 0)
+    {
+      os << " (" << entry["unchecked"].asUInt64() << " unchecked)";
+    }
+    os << std::endl;
+  }
+  printHeader("Sync read", "devices", "bytes/s");
+  for (const Json::Value& entry : results["syncRead"])
+  {
+    os << std::setw(12) << entry["devices"].asUInt64();
+    printTiming(entry);
+    os << std::setw(14) << std::setprecision(0) << entry["bytesPerSec"].asDouble() << std::endl;
+  }
+  printHeader("Sync write", "devices", "bytes/s");
+  for (const Json::Value& entry : results["syncWrite"])
+  {
+    os << std::setw(12) << entry["devices"].asUInt64();
+    printTiming(entry);
+    os << std::setw(14) << std::setprecision(0) << entry["bytesPerSec"].asDouble() << std::endl;
+  }
+  const Json::Value& flush = results["flush"];
+  if (flush.isMember("count"))
+  {
+    printHeader("Flush", "", "rate(Hz)");
+    os << std::setw(12) << "";
+    printTiming(flush);
+    os << std::setw(14) << std::setprecision(1) << flush["rateHz"].asDouble() << std::endl;
+    os << "Flush errors: write=" << flush["writeErrorCount"].asUInt64()
+       << " device=" << flush["deviceErrorCount"].asUInt64() << " warning=" << flush["deviceWarningCount"].asUInt64()
+       << std::endl;
+  }
+  os << std::endl
+     << "Bus errors: " << results["errors"]["errors"].asUInt64() << "/" << results["errors"]["count"].asUInt64()
+     << " (" << std::setprecision(3) << 100.0 * results["errors"]["errorRate"].asDouble() << "%)" << std::endl;
+}
+
+std::vector<Device*> Bench::presentDevices() const
+{
+  // Device container is
+  // sorted by id
+  std::vector<Device*> devs;
+  for (const auto& dev : _manager._devicesById)
+  {
+    if (dev.second->isPresent())
+    {
+      devs.push_back(dev.second);
+    }
+  }
+  return devs;
+}
+
+bool Bench::writableRange(const Device* dev, addr_t& addr, size_t& length)
+{
+  std::vector<const Register*> regs;
+  for (const auto& reg : dev->registersList().container())
+  {
+    regs.push_back(reg.second);
+  }
+  std::sort(regs.begin(), regs.end(), [](const Register* r1, const Register* r2) { return r1->addr < r2->addr; });
+  // Find the first eligible Register
+  // and extend the range while the
+  // next Registers are contiguous and
+  // eligible
+  bool isFound = false;
+  size_t end = 0;
+  for (const Register* reg : regs)
+  {
+    bool isEligible = !reg->isReadOnly && !reg->isSlowRegister;
+    if (!isFound)
+    {
+      if (isEligible)
+      {
+        isFound = true;
+        addr = reg->addr;
+        end = reg->addr + reg->length;
+      }
+      continue;
+    }
+    if (reg->addr > end)
+    {
+      break;
+    }
+    if (!isEligible)
+    {
+      end = std::min(end, (size_t)reg->addr);
+      break;
+    }
+    end = std::max(end, (size_t)(reg->addr + reg->length));
+  }
+  if (!isFound || end <= addr)
+  {
+    return false;
+  }
+  length = end - addr;
+  return true;
+}
+
+std::vector<size_t> Bench::deviceCounts(size_t total)
+{
+  std::vector<size_t> counts;
+  for (size_t n = 1; n < total; n *= 2)
+  {
+    counts.push_back(n);
+  }
+  if (total > 0)
+  {
+    counts.push_back(total);
+  }
+  return counts;
+}
+
+}  // namespace RhAL
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include <json/json.h>
+#include "types.h"
+
+namespace RhAL
+{
+/**
+ * Forward declaration
+ */
+class BaseManager;
+class Device;
+
+/**
+ * Bench
+ *
+ * Bus qualification tool measuring on the
+ * present Devices of a scanned Manager (live
+ * bus or simulator): ping latency per id,
+ * single read and write round trips per size,
+ * sync read and sync write throughput versus
+ * number of Devices, achievable flush rate
+ * with the current configuration, and error
+ * rates of all of them.
+ * Write measurements only write back the bytes
+ * just read from the first contiguous range of
+ * writable non slow (RAM) Registers of each
+ * Device, so that the Devices state is unchanged.
+ * Failed pre-reads are counted apart from the
+ * write timings, and writes to Devices without
+ * write status packet are sent unchecked.
+ * Results are returned as json and can be
+ * formatted as a text table.
+ * The Manager thread must not be running.
+ */
+class Bench
+{
+public:
+  /**
+   * Initialization with the Manager
+   * and the number of transactions
+   * of each measurement
+   */
+  Bench(BaseManager& manager, unsigned int iterations = 100);
+
+  /**
+   * Run all measurements and
+   * return the json results
+   */
+  Json::Value run();
+
+  /**
+   * Measure ping latency
+   * of each present Device
+   */
+  Json::Value benchPing();
+
+  /**
+   * Measure single read and write
+   * round trips for each given size
+   */
+  Json::Value benchRead(const std::vector<size_t>& sizes = { 1, 2, 4, 8, 16, 32 });
+  Json::Value benchWrite(const std::vector<size_t>& sizes = { 1, 2, 4, 8, 16, 32 });
+
+  /**
+   * Measure sync read and sync write
+   * throughput of given size for increasing
+   * number of Devices (powers of 2 and all).
+   * Skipped if disabled in Manager Parameters.
+   */
+  Json::Value benchSyncRead(size_t size = 8);
+  Json::Value benchSyncWrite(size_t size = 4);
+
+  /**
+   * Measure the Manager flush period
+   * and rate with current Registers
+   * and Parameters configuration.
+   * Skipped if schedule mode is disabled.
+   */
+  Json::Value benchFlush();
+
+  /**
+   * Print given run() results
+   * as text tables in given stream
+   */
+  static void printTable(std::ostream& os, const Json::Value& results);
+
+private:
+  /**
+   * Duration and error accumulator
+   * over a set of transactions
+   */
+  struct Timing
+  {
+    unsigned long count;
+    unsigned long errors;
+    double sum;
+    double min;
+    double max;
+
+    Timing();
+    void add(double duration, bool isOK);
+    Json::Value toJSON() const;
+  };
+
+  /**
+   * Benchmarked Manager
+   */
+  BaseManager& _manager;
+
+  /**
+   * Number of transactions
+   * for each measurement
+   */
+  unsigned int _iterations;
+
+  /**
+   * Return present Devices sorted by id
+   */
+  std::vector<Device*> presentDevices() const;
+
+  /**
+   * Compute the first contiguous range of
+   * writable and non slow Registers of given
+   * Device. Return false if none is found.
+   */
+  static bool writableRange(const Device* dev, addr_t& addr, size_t& length);
+
+  /**
+   * Return the increasing Device
+   * counts to measure for given total
+   */
+  static std::vector<size_t> deviceCounts(size_t total);
+};
+
+}  // namespace RhAL
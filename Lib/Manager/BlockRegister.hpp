@@ -0,0 +1,223 @@
+#pragma once
+
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include "Register.hpp"
+#include "CallManager.hpp"
+
+namespace RhAL
+{
+/**
+ * Template alias for block conversion
+ * function from value to raw data
+ * buffer and inverse
+ */
+template <typename T>
+using FuncBlockEncode = std::function<void(data_t*, const T&)>;
+template <typename T>
+using FuncBlockDecode = std::function<T(const data_t*)>;
+
+/**
+ * BlockRegister
+ *
+ * Register spanning an arbitrary length of
+ * device memory (up to the whole control table)
+ * decoded as one value of template type T
+ * (typically a fixed size array or a user struct
+ * holding a full sensor frame).
+ * The block is selected, read, swapped and
+ * decoded as one unit.
+ * Only the last written value is kept
+ * (no aggregation). Block Registers have no
+ * number view (snapshot and recorder values
+ * are NaN) and are not exported by bindings.
+ */
+template <typename T>
+class BlockRegister : public Register
+{
+public:
+  /**
+   * Conversion functions from block
+   * value to data buffer and inverse
+   */
+  const FuncBlockEncode<T> funcConvEncode;
+  const FuncBlockDecode<T> funcConvDecode;
+
+  /**
+   * Initialization with Register
+   * configuration and conversion
+   * functions (see TypedRegister).
+   */
+  BlockRegister(const std::string& name, addr_t addr, size_t length, FuncBlockEncode<T> funcConvEncode,
+                FuncBlockDecode<T> funcConvDecode, unsigned int periodPackedRead = 0, bool forceRead = false,
+                bool forceWrite = false, bool isSlowRegister = false)
+    : Register(name, addr, length, periodPackedRead, forceRead, forceWrite, isSlowRegister, false)
+    , funcConvEncode(funcConvEncode)
+    , funcConvDecode(funcConvDecode)
+    , _valueRead()
+    , _valueWrite()
+    , _callbackOnRead([](const T& val) { (void)val; })
+  {
+  }
+
+  /**
+   * Initialization for read only
+   * block Register
+   */
+  BlockRegister(const std::string& name, addr_t addr, size_t length, FuncBlockDecode<T> funcConvDecode,
+                unsigned int periodPackedRead = 0, bool forceRead = false, bool forceWrite = false,
+                bool isSlowRegister = false)
+    : Register(name, addr, length, periodPackedRead, forceRead, forceWrite, isSlowRegister, true)
+    , funcConvEncode()
+    , funcConvDecode(funcConvDecode)
+    , _valueRead()
+    , _valueWrite()
+    , _callbackOnRead([](const T& val) { (void)val; })
+  {
+  }
+
+  /**
+   * Initialization for read only block
+   * Register decoded by raw memory copy
+   * (T has to be trivially copyable and its
+   * layout has to match the device memory)
+   */
+  BlockRegister(const std::string& name, addr_t addr, unsigned int periodPackedRead = 0, bool forceRead = false)
+    : BlockRegister(name, addr, sizeof(T), rawDecode, periodPackedRead, forceRead)
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "BlockRegister raw decode of non trivially copyable type");
+  }
+
+  /**
+   * Set the on manager read callback.
+   * The decoded block is given as argument.
+   */
+  void setCallbackRead(std::function<void(const T&)> func)
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _callbackOnRead = func;
+  }
+
+  /**
+   * Return the last read block from
+   * the hardware (see TypedRegister).
+   */
+  ReadValue<T> readValue(bool noForceRead = false)
+  {
+    if (!noForceRead && (isForceRead || !_manager->isScheduleMode()))
+    {
+      forceRead();
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    return ReadValue<T>(_lastDevReadUser, _valueRead, _isLastReadError);
+  }
+
+  /**
+   * Set the block to be written
+   * (replacing any previous write)
+   */
+  void writeValue(const T& val)
+  {
+    if (isReadOnly)
+    {
+      throw std::logic_error("BlockRegister write to read only Register: " + name);
+    }
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _valueWrite = val;
+      _lastUserWrite = (_manager != nullptr) ? _manager->clock().now() : getTimePoint();
+      _needWrite = true;
+    }
+    if (isForceWrite || !_manager->isScheduleMode())
+    {
+      forceWrite();
+    }
+  }
+
+  /**
+   * Return the current write block
+   */
+  T getWrittenValue() const
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _valueWrite;
+  }
+
+  /**
+   * Inherit.
+   */
+  virtual double decodeNumber(const data_t* data) const override
+  {
+    (void)data;
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+
+protected:
+  /**
+   * Inherit.
+   */
+  virtual void doConvEncode() override
+  {
+    if (isReadOnly)
+    {
+      throw std::logic_error("BlockRegister conv encode on read only Register: " + name);
+    }
+    funcConvEncode(_dataBufferWrite, _valueWrite);
+  }
+  virtual void doConvDecode() override
+  {
+    _valueRead = funcConvDecode(_dataBufferRead);
+    // Call or queue (always coalesced
+    // since the block has no number view)
+    CallbackExecutor* executor = (_manager != nullptr) ? &_manager->callbackExecutor() : nullptr;
+    if (executor == nullptr || !executor->isEnabled())
+    {
+      _callbackOnRead(_valueRead);
+    }
+    else if (!_isCallbackPending)
+    {
+      _isCallbackPending = true;
+      if (!executor->push(CallbackTask{ this, 0.0, true }))
+      {
+        _isCallbackPending = false;
+        _callbackOnRead(_valueRead);
+      }
+    }
+  }
+  virtual double doReadNumber() const override
+  {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  virtual void runCallbackRead(const CallbackTask& task) override
+  {
+    (void)task;
+    std::unique_lock<std::mutex> lock(_mutex);
+    T value = _valueRead;
+    _isCallbackPending = false;
+    std::function<void(const T&)> callback = _callbackOnRead;
+    lock.unlock();
+    callback(value);
+  }
+
+private:
+  /**
+   * Read and write block values
+   * and user read callback
+   */
+  T _valueRead;
+  T _valueWrite;
+  std::function<void(const T&)> _callbackOnRead;
+
+  /**
+   * Raw memory copy decode
+   */
+  static T rawDecode(const data_t* data)
+  {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+  }
+};
+
+}  // namespace RhAL
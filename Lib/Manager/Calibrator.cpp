@@ -0,0 +1,102 @@
+#include <cmath>
+#include <stdexcept>
+#include "Calibrator.hpp"
+
+namespace RhAL
+{
+Calibrator::Calibrator() : _mutex(), _jobs()
+{
+}
+
+std::future<CalibrationResult> Calibrator::start(size_t channels, size_t samples, FuncSample sample, FuncApply apply,
+                                                 size_t skip, size_t maxCycles)
+{
+  if (channels == 0 || samples == 0)
+  {
+    throw std::logic_error("Calibrator invalid channels or samples count");
+  }
+  std::unique_ptr<Job> job(new Job());
+  job->samples = samples;
+  job->skip = skip;
+  job->maxCycles = maxCycles;
+  job->cycles = 0;
+  job->sample = sample;
+  job->apply = apply;
+  job->count = 0;
+  job->means.assign(channels, 0.0);
+  job->m2.assign(channels, 0.0);
+  job->values.assign(channels, 0.0);
+  std::future<CalibrationResult> future = job->promise.get_future();
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  _jobs.push_back(std::move(job));
+  return future;
+}
+
+size_t Calibrator::count() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _jobs.size();
+}
+
+void Calibrator::update()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  for (size_t i = 0; i < _jobs.size();)
+  {
+    Job& job = *_jobs[i];
+    if (job.skip > 0)
+    {
+      job.skip--;
+      i++;
+      continue;
+    }
+    try
+    {
+      // Welford online update of all channels
+      job.cycles++;
+      if (job.sample(job.values.data()))
+      {
+        job.count++;
+        double inv = 1.0 / job.count;
+        for (size_t k = 0; k < job.values.size(); k++)
+        {
+          double delta = job.values[k] - job.means[k];
+          job.means[k] += delta * inv;
+          job.m2[k] += delta * (job.values[k] - job.means[k]);
+        }
+      }
+      if (job.count < job.samples && job.maxCycles > 0 && job.cycles >= job.maxCycles)
+      {
+        throw std::runtime_error("Calibrator timeout: " + std::to_string(job.count) + "/" +
+                                 std::to_string(job.samples) + " samples in " + std::to_string(job.cycles) +
+                                 " cycles");
+      }
+      if (job.count < job.samples)
+      {
+        i++;
+        continue;
+      }
+      // Apply and complete
+      CalibrationResult result;
+      result.count = job.count;
+      result.means = job.means;
+      result.deviations.resize(job.m2.size());
+      for (size_t k = 0; k < job.m2.size(); k++)
+      {
+        result.deviations[k] = std::sqrt(job.m2[k] / job.count);
+      }
+      job.apply(result);
+      job.promise.set_value(result);
+    }
+    catch (...)
+    {
+      // Sampling, apply failure or
+      // timeout is given to the future
+      job.promise.set_exception(std::current_exception());
+    }
+    _jobs.erase(_jobs.begin() + i);
+  }
+}
+
+}  // namespace RhAL
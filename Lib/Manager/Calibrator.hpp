@@ -0,0 +1,120 @@
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <memory>
+#include <future>
+#include <functional>
+
+namespace RhAL
+{
+/**
+ * Result of a calibration with
+ * mean and standard deviation of
+ * each channel over all samples
+ */
+struct CalibrationResult
+{
+  size_t count;
+  std::vector<double> means;
+  std::vector<double> deviations;
+};
+
+/**
+ * Calibrator
+ *
+ * Manager level engine accumulating
+ * calibration samples incrementally during the
+ * swap phase of each flush (after Devices onSwap()).
+ * Each calibration samples a given number of
+ * channels once per flush until the requested
+ * count is reached, using Welford's online mean
+ * and variance (no sample is stored). The apply
+ * function is then called in the swap phase, so
+ * that all offsets are changed atomically with
+ * respect to the Manager cycle, and the returned
+ * future is set. A calibration not completed
+ * within its maximum number of cycles is aborted
+ * and its future holds a std::runtime_error.
+ * Thread safe.
+ */
+class Calibrator
+{
+public:
+  /**
+   * Sampling function filling given array
+   * with one value per channel. Return false
+   * if no sample is available this cycle.
+   */
+  typedef std::function<bool(double* values)> FuncSample;
+
+  /**
+   * Apply function called once
+   * with the final result
+   */
+  typedef std::function<void(const CalibrationResult& result)> FuncApply;
+
+  /**
+   * Initialization
+   */
+  Calibrator();
+
+  /**
+   * Start a calibration of given number of
+   * channels over given number of samples.
+   * The first skip cycles are not sampled
+   * (waiting for values decoded after a
+   * possible offset reset).
+   * The calibration fails if the samples are
+   * not all taken within maxCycles cycles after
+   * the skipped ones (0 for no limit).
+   * Return the future result.
+   */
+  std::future<CalibrationResult> start(size_t channels, size_t samples, FuncSample sample, FuncApply apply,
+                                       size_t skip = 1, size_t maxCycles = 0);
+
+  /**
+   * Return the number of
+   * running calibrations
+   */
+  size_t count() const;
+
+  /**
+   * Sample all running calibrations and
+   * apply the completed ones.
+   * Called by the Manager at each flush.
+   */
+  void update();
+
+private:
+  /**
+   * Running calibration state
+   */
+  struct Job
+  {
+    size_t samples;
+    size_t skip;
+    size_t maxCycles;
+    size_t cycles;
+    FuncSample sample;
+    FuncApply apply;
+    // Welford accumulators
+    size_t count;
+    std::vector<double> means;
+    std::vector<double> m2;
+    std::vector<double> values;
+    std::promise<CalibrationResult> promise;
+  };
+
+  /**
+   * Mutex protecting the jobs
+   */
+  mutable std::mutex _mutex;
+
+  /**
+   * Running calibrations
+   */
+  std::vector<std::unique_ptr<Job>> _jobs;
+};
+
+}  // namespace RhAL
@@ -2,7 +2,13 @@
 
 namespace RhAL
 {
-CallManager::CallManager() : _paramScheduleMode("scheduleMode", true)
+CallManager::CallManager()
+  : _paramScheduleMode("scheduleMode", true)
+  , _mutex()
+  , _callbackExecutor()
+  , _interpolator()
+  , _calibrator()
+  , _clock(&defaultClock())
 {
 }
 
@@ -21,4 +27,24 @@ void CallManager::setScheduleMode(bool mode)
   _paramScheduleMode.value = mode;
 }
 
+CallbackExecutor& CallManager::callbackExecutor()
+{
+  return _callbackExecutor;
+}
+
+Interpolator& CallManager::interpolator()
+{
+  return _interpolator;
+}
+
+Calibrator& CallManager::calibrator()
+{
+  return _calibrator;
+}
+
+Clock& CallManager::clock() const
+{
+  return *_clock.load();
+}
+
 }  // namespace RhAL
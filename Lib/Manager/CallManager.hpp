@@ -2,9 +2,14 @@
 
 #include <string>
 #include <mutex>
+#include <atomic>
 #include "types.h"
 #include "timestamp.h"
+#include "Clock.hpp"
 #include "Parameter.hpp"
+#include "CallbackExecutor.hpp"
+#include "Interpolator.hpp"
+#include "Calibrator.hpp"
 
 namespace RhAL
 {
@@ -67,6 +72,33 @@ public:
    */
   void setScheduleMode(bool mode);
 
+  /**
+   * Return the executor running Registers
+   * read callbacks (disabled by default:
+   * callbacks are then called synchronously
+   * during swap)
+   */
+  CallbackExecutor& callbackExecutor();
+
+  /**
+   * Return the engine interpolating
+   * Registers values at each flush
+   */
+  Interpolator& interpolator();
+
+  /**
+   * Return the engine running
+   * calibrations at each flush
+   */
+  Calibrator& calibrator();
+
+  /**
+   * Return the clock used by the Manager,
+   * its Protocol and Devices for timestamps
+   * and waits (real steady clock by default)
+   */
+  Clock& clock() const;
+
 protected:
   /**
    * Send mode. If false (default behaviour is true),
@@ -81,6 +113,30 @@ protected:
    * but not protecting the bus access
    */
   mutable std::mutex _mutex;
+
+  /**
+   * Registers read callbacks
+   * thread pool
+   */
+  CallbackExecutor _callbackExecutor;
+
+  /**
+   * Registers values interpolation
+   * engine updated at each flush
+   */
+  Interpolator _interpolator;
+
+  /**
+   * Calibrations sampling
+   * engine updated at each flush
+   */
+  Calibrator _calibrator;
+
+  /**
+   * Time source (not owned), read
+   * by Registers without lock
+   */
+  std::atomic<Clock*> _clock;
 };
 
 }  // namespace RhAL
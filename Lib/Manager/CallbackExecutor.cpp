@@ -0,0 +1,224 @@
+#include <chrono>
+#include "Manager/CallbackExecutor.hpp"
+#include "Manager/Register.hpp"
+
+namespace RhAL
+{
+/**
+ * Return the smallest power
+ * of 2 greater or equal to given size
+ */
+static size_t roundUpPowerOf2(size_t size)
+{
+  size_t p = 2;
+  while (p < size)
+  {
+    p *= 2;
+  }
+  return p;
+}
+
+CallbackExecutor::Shard::Shard(size_t capacity)
+  : ring(roundUpPowerOf2(capacity))
+  , mask(roundUpPowerOf2(capacity) - 1)
+  , enqueuePos(0)
+  , dequeuePos(0)
+  , thread()
+  , mutexWait()
+  , condWait()
+{
+  for (size_t i = 0; i < ring.size(); i++)
+  {
+    ring[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+CallbackExecutor::CallbackExecutor(size_t capacity)
+  : _capacity(capacity)
+  , _isEnabled(false)
+  , _isCoalescing(true)
+  , _isContinue(false)
+  , _overflowCount(0)
+  , _shards()
+  , _mutexControl()
+{
+}
+
+CallbackExecutor::~CallbackExecutor()
+{
+  stop();
+}
+
+void CallbackExecutor::start(unsigned int threads, bool isCoalescing)
+{
+  std::lock_guard<std::mutex> lock(_mutexControl);
+  doStop();
+  _isCoalescing = isCoalescing;
+  _overflowCount = 0;
+  if (threads == 0)
+  {
+    return;
+  }
+  _isContinue = true;
+  for (unsigned int i = 0; i < threads; i++)
+  {
+    _shards.emplace_back(new Shard(_capacity));
+  }
+  for (std::unique_ptr<Shard>& shard : _shards)
+  {
+    Shard* pt = shard.get();
+    shard->thread = std::thread([this, pt]() { this->run(*pt); });
+  }
+  _isEnabled = true;
+}
+
+void CallbackExecutor::stop()
+{
+  std::lock_guard<std::mutex> lock(_mutexControl);
+  doStop();
+}
+
+void CallbackExecutor::disable()
+{
+  _isEnabled = false;
+}
+
+bool CallbackExecutor::isEnabled() const
+{
+  return _isEnabled;
+}
+
+bool CallbackExecutor::isCoalescing() const
+{
+  return _isCoalescing;
+}
+
+bool CallbackExecutor::push(const CallbackTask& task)
+{
+  if (!_isEnabled)
+  {
+    return false;
+  }
+  // Shard by Register so that its
+  // callbacks are run in order
+  Shard& shard = *_shards[(task.reg->id * 256 + task.reg->addr) % _shards.size()];
+  size_t pos = shard.enqueuePos.load(std::memory_order_relaxed);
+  Cell* cell;
+  while (true)
+  {
+    cell = &shard.ring[pos & shard.mask];
+    size_t seq = cell->sequence.load(std::memory_order_acquire);
+    intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+    if (diff == 0)
+    {
+      // Free cell, try to claim it
+      if (shard.enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+      {
+        break;
+      }
+    }
+    else if (diff < 0)
+    {
+      // The ring is full
+      _overflowCount++;
+      return false;
+    }
+    else
+    {
+      pos = shard.enqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+  cell->task = task;
+  cell->sequence.store(pos + 1, std::memory_order_release);
+  shard.condWait.notify_one();
+
+  return true;
+}
+
+unsigned long CallbackExecutor::countOverflows() const
+{
+  return _overflowCount;
+}
+
+void CallbackExecutor::doStop()
+{
+  // Stop accepting new tasks
+  _isEnabled = false;
+  if (_shards.empty())
+  {
+    return;
+  }
+  _isContinue = false;
+  for (std::unique_ptr<Shard>& shard : _shards)
+  {
+    shard->condWait.notify_all();
+  }
+  for (std::unique_ptr<Shard>& shard : _shards)
+  {
+    shard->thread.join();
+  }
+  // Run tasks pushed before disabling
+  for (std::unique_ptr<Shard>& shard : _shards)
+  {
+    CallbackTask task;
+    while (pop(*shard, task))
+    {
+      task.reg->runCallbackRead(task);
+    }
+  }
+  _shards.clear();
+}
+
+bool CallbackExecutor::pop(Shard& shard, CallbackTask& task)
+{
+  size_t pos = shard.dequeuePos.load(std::memory_order_relaxed);
+  Cell* cell;
+  while (true)
+  {
+    cell = &shard.ring[pos & shard.mask];
+    size_t seq = cell->sequence.load(std::memory_order_acquire);
+    intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+    if (diff == 0)
+    {
+      // Filled cell, try to claim it
+      if (shard.dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+      {
+        break;
+      }
+    }
+    else if (diff < 0)
+    {
+      // The ring is empty
+      return false;
+    }
+    else
+    {
+      pos = shard.dequeuePos.load(std::memory_order_relaxed);
+    }
+  }
+  task = cell->task;
+  cell->sequence.store(pos + shard.mask + 1, std::memory_order_release);
+
+  return true;
+}
+
+void CallbackExecutor::run(Shard& shard)
+{
+  CallbackTask task;
+  while (_isContinue)
+  {
+    if (pop(shard, task))
+    {
+      task.reg->runCallbackRead(task);
+    }
+    else
+    {
+      // Producers notify without holding the
+      // lock, the timeout bounds a missed wake up
+      std::unique_lock<std::mutex> lock(shard.mutexWait);
+      shard.condWait.wait_for(lock, std::chrono::milliseconds(1));
+    }
+  }
+}
+
+}  // namespace RhAL
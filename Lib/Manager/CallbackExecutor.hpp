@@ -0,0 +1,191 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+namespace RhAL
+{
+// Forward declaration
+class Register;
+
+/**
+ * CallbackTask
+ *
+ * Queued Register read callback.
+ * If isCoalesced is true, the callback
+ * is called with the Register latest read
+ * value at execution time. Else, with
+ * the given value (bool, int and float
+ * are stored as double).
+ */
+struct CallbackTask
+{
+  Register* reg;
+  double value;
+  bool isCoalesced;
+};
+
+/**
+ * CallbackExecutor
+ *
+ * Pool of threads running Register read
+ * callbacks out of the Manager critical section.
+ * Each worker thread owns a bounded lock free
+ * ring buffer (multiple producers, sequence
+ * numbered cells) and tasks are sharded by
+ * Register, so that the callbacks of a given
+ * Register are always run by the same worker
+ * in their read order.
+ * Disabled (synchronous callbacks) if
+ * started with zero thread.
+ * Tasks are pushed under the Manager mutex,
+ * start() and stop() join the workers (which may
+ * lock the Manager in user callbacks) and must be
+ * called without holding it, after disable().
+ */
+class CallbackExecutor
+{
+public:
+  /**
+   * Initialization with each worker
+   * ring capacity (rounded up to
+   * a power of 2)
+   */
+  CallbackExecutor(size_t capacity = 4096);
+
+  /**
+   * Stop pending threads
+   */
+  ~CallbackExecutor();
+
+  /**
+   * Copy constructor and
+   * assignement are forbidden
+   */
+  CallbackExecutor(const CallbackExecutor&) = delete;
+  CallbackExecutor& operator=(const CallbackExecutor&) = delete;
+
+  /**
+   * Stop then restart the pool with given
+   * number of threads and coalescing mode.
+   * Zero thread disables the executor.
+   */
+  void start(unsigned int threads, bool isCoalescing);
+
+  /**
+   * Run all remaining queued tasks
+   * and join the threads
+   */
+  void stop();
+
+  /**
+   * Stop accepting new tasks (callers then
+   * run their callbacks synchronously).
+   * To be called under the Manager mutex
+   * before start() or stop() so that no
+   * push is in progress.
+   */
+  void disable();
+
+  /**
+   * Return true if threads are running
+   */
+  bool isEnabled() const;
+
+  /**
+   * Return true if only the latest value
+   * of each Register has to be delivered
+   */
+  bool isCoalescing() const;
+
+  /**
+   * Push a task in the ring of the worker
+   * owning its Register. Lock free.
+   * Return false if the executor is
+   * disabled or the ring is full
+   * (the caller is then expected to
+   * run the callback itself).
+   */
+  bool push(const CallbackTask& task);
+
+  /**
+   * Return the number of tasks that
+   * could not be queued since start
+   */
+  unsigned long countOverflows() const;
+
+private:
+  /**
+   * Ring buffer cell with its
+   * sequence number
+   */
+  struct Cell
+  {
+    std::atomic<size_t> sequence;
+    CallbackTask task;
+  };
+
+  /**
+   * Worker thread with its ring buffer,
+   * capacity mask, enqueue/dequeue
+   * positions and wake up condition
+   */
+  struct Shard
+  {
+    std::vector<Cell> ring;
+    size_t mask;
+    std::atomic<size_t> enqueuePos;
+    std::atomic<size_t> dequeuePos;
+    std::thread thread;
+    std::mutex mutexWait;
+    std::condition_variable condWait;
+
+    Shard(size_t capacity);
+  };
+
+  /**
+   * Each worker ring capacity
+   */
+  size_t _capacity;
+
+  /**
+   * Running state and modes
+   */
+  std::atomic<bool> _isEnabled;
+  std::atomic<bool> _isCoalescing;
+  std::atomic<bool> _isContinue;
+  std::atomic<unsigned long> _overflowCount;
+
+  /**
+   * Workers indexed by shard
+   */
+  std::vector<std::unique_ptr<Shard>> _shards;
+
+  /**
+   * Mutex serializing start() and stop()
+   */
+  std::mutex _mutexControl;
+
+  /**
+   * Join the workers and run remaining
+   * tasks (called with control mutex)
+   */
+  void doStop();
+
+  /**
+   * Pop a task from given worker ring.
+   * Return false if empty.
+   */
+  static bool pop(Shard& shard, CallbackTask& task);
+
+  /**
+   * Worker threads main loop
+   */
+  void run(Shard& shard);
+};
+
+}  // namespace RhAL
@@ -53,6 +53,24 @@ void Device::init()
   onInit();
 }
 
+Clock& Device::clock() const
+{
+  if (_manager == nullptr)
+  {
+    throw std::logic_error("Device null manager pointer: " + _name);
+  }
+  return _manager->clock();
+}
+
+Interpolator& Device::interpolator() const
+{
+  if (_manager == nullptr)
+  {
+    throw std::logic_error("Device null manager pointer: " + _name);
+  }
+  return _manager->interpolator();
+}
+
 const std::string& Device::name() const
 {
   return _name;
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <mutex>
+#include <vector>
 #include "types.h"
 #include "timestamp.h"
 #include "ConvertionUtils.h"
@@ -13,6 +14,25 @@ namespace RhAL
 {
 // Forward declaration
 class CallManager;
+class Interpolator;
+
+/**
+ * Desired encoded value of a
+ * configuration Register (see
+ * Device::getConfig()). Bytes are encoded
+ * with the Register conversion function.
+ */
+struct ConfigValue
+{
+  Register* reg;
+  data_t data[MaxRegisterLength];
+
+  template <typename T>
+  ConfigValue(TypedRegister<T>& reg, T value) : reg(&reg), data()
+  {
+    reg.funcConvEncode(data, value);
+  }
+};
 
 /**
  * Device
@@ -76,6 +96,64 @@ public:
     // Empty default
   }
 
+  /**
+   * Append to given container the desired
+   * values of the Device configuration Registers
+   * (typically EEPROM). The Manager reads them
+   * back, diffs and only writes differing bytes
+   * (see BaseManager::setDevicesConfig()).
+   */
+  virtual inline void getConfig(std::vector<ConfigValue>& config)
+  {
+    (void)config;
+    // Empty default
+  }
+
+  /**
+   * Append to given container the Registers
+   * values of the Device link configuration.
+   * If isOptimized, values minimize the link
+   * latency (return delay, status packets) and if
+   * isWriteStatus is false, status packets are not
+   * needed after writes. Else the default status
+   * packets are restored. Used by the
+   * configuration sync.
+   */
+  virtual inline void getLinkConfig(std::vector<ConfigValue>& config, bool isOptimized, bool isWriteStatus)
+  {
+    (void)config;
+    (void)isOptimized;
+    (void)isWriteStatus;
+    // Empty default
+  }
+
+  /**
+   * Assign the address of the Device baudrate
+   * Register and its raw value for given bus
+   * baudrate in BPS. Return false if the Device
+   * does not support this baudrate.
+   * (see BaseManager::negotiateBaudrate())
+   */
+  virtual inline bool baudrateCode(unsigned long baudrate, addr_t& addr, data_t& code) const
+  {
+    (void)baudrate;
+    (void)addr;
+    (void)code;
+    // No baudrate configuration
+    return false;
+  }
+
+  /**
+   * Notify the device that its Parameters
+   * values have been externally changed
+   * (JSON loading, RhIO binding) so that
+   * derived state can be refreshed
+   */
+  virtual inline void onParametersUpdate()
+  {
+    // Empty default
+  }
+
   /**
    * Return true if the device has
    * been see and is supposed
@@ -132,6 +210,18 @@ protected:
    */
   mutable std::mutex _mutex;
 
+  /**
+   * Return the Manager clock
+   * (the Device has to be initialized)
+   */
+  Clock& clock() const;
+
+  /**
+   * Return the Manager interpolation engine
+   * (the Device has to be initialized)
+   */
+  Interpolator& interpolator() const;
+
   /**
    * Set Device isPresent and warning/error status.
    * (Used for friend Manager access)
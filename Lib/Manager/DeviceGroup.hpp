@@ -0,0 +1,207 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include "Manager/Register.hpp"
+#include "Manager/CallManager.hpp"
+
+namespace RhAL
+{
+/**
+ * DeviceGroup
+ *
+ * Fixed ordered view over Devices of
+ * same type T exposing present position,
+ * speed, load and goal position as
+ * contiguous float arrays (structure of arrays).
+ * Registers are resolved once at construction so
+ * that a whole group read/modify/write is free
+ * of any name lookup, and goal positions are
+ * written in one pass with a shared timestamp.
+ * Values are still decoded and encoded per
+ * Register by the Manager flush.
+ * T is expected to provide position(), speed(),
+ * load() and goalPosition() float registers
+ * (DXL interface).
+ * Not thread safe: a group is supposed
+ * to be owned by a single control thread.
+ */
+template <typename T>
+class DeviceGroup
+{
+public:
+  /**
+   * Initialization with the Manager
+   * and ordered Devices pointers.
+   * Goal positions are initialized with
+   * current Registers written values.
+   */
+  DeviceGroup(const CallManager& manager, const std::vector<T*>& devices)
+    : _manager(manager)
+    , _devices(devices)
+    , _isForceWrite(false)
+    , _regsPosition()
+    , _regsSpeed()
+    , _regsLoad()
+    , _regsGoalPosition()
+    , _positions(devices.size(), 0.0f)
+    , _speeds(devices.size(), 0.0f)
+    , _loads(devices.size(), 0.0f)
+    , _goalPositions(devices.size(), 0.0f)
+  {
+    for (T* dev : _devices)
+    {
+      if (dev == nullptr)
+      {
+        throw std::logic_error("DeviceGroup null Device pointer");
+      }
+      _regsPosition.push_back(&dev->position());
+      _regsSpeed.push_back(&dev->speed());
+      _regsLoad.push_back(&dev->load());
+      _regsGoalPosition.push_back(&dev->goalPosition());
+      _isForceWrite = _isForceWrite || dev->goalPosition().isForceWrite;
+    }
+    for (size_t i = 0; i < _devices.size(); i++)
+    {
+      _goalPositions[i] = _regsGoalPosition[i]->getWrittenValue();
+    }
+  }
+
+  /**
+   * Return the number of grouped Devices
+   */
+  inline size_t size() const
+  {
+    return _devices.size();
+  }
+
+  /**
+   * Return the Device at given
+   * index in group order
+   */
+  inline T& dev(size_t index)
+  {
+    return *_devices.at(index);
+  }
+  inline const T& dev(size_t index) const
+  {
+    return *_devices.at(index);
+  }
+
+  /**
+   * Mark present position, speed and load
+   * of all grouped Devices to be read by next
+   * flush (packed in one sync read)
+   */
+  inline void askRead()
+  {
+    for (size_t i = 0; i < _devices.size(); i++)
+    {
+      _regsPosition[i]->askRead();
+      _regsSpeed[i]->askRead();
+      _regsLoad[i]->askRead();
+    }
+  }
+
+  /**
+   * Copy last read values (decoded by
+   * the Manager during last flush) of all
+   * grouped Devices into contiguous arrays.
+   * No immediate read is done on the bus.
+   */
+  inline void read()
+  {
+    size_t count = _devices.size();
+    TypedRegisterFloat::readValues(_regsPosition.data(), _positions.data(), count);
+    TypedRegisterFloat::readValues(_regsSpeed.data(), _speeds.data(), count);
+    TypedRegisterFloat::readValues(_regsLoad.data(), _loads.data(), count);
+  }
+
+  /**
+   * Write goal positions array back to all
+   * grouped Devices. In schedule mode, Registers
+   * are only marked to be written by next flush
+   * (and batched in one sync write), else they
+   * are immediately written one by one.
+   */
+  inline void write()
+  {
+    if (_isForceWrite || !_manager.isScheduleMode())
+    {
+      for (size_t i = 0; i < _regsGoalPosition.size(); i++)
+      {
+        _regsGoalPosition[i]->writeValue(_goalPositions[i]);
+      }
+      return;
+    }
+    TypedRegisterFloat::writeValues(_regsGoalPosition.data(), _goalPositions.data(), _regsGoalPosition.size(),
+                                    _manager.clock().now());
+  }
+
+  /**
+   * Contiguous read values arrays
+   * (updated by read())
+   */
+  inline const float* positions() const
+  {
+    return _positions.data();
+  }
+  inline const float* speeds() const
+  {
+    return _speeds.data();
+  }
+  inline const float* loads() const
+  {
+    return _loads.data();
+  }
+
+  /**
+   * Contiguous goal positions array
+   * (sent by write())
+   */
+  inline float* goalPositions()
+  {
+    return _goalPositions.data();
+  }
+  inline const float* goalPositions() const
+  {
+    return _goalPositions.data();
+  }
+
+private:
+  /**
+   * Manager of grouped Devices
+   */
+  const CallManager& _manager;
+
+  /**
+   * Grouped Devices in user order
+   */
+  std::vector<T*> _devices;
+
+  /**
+   * True if a goal position
+   * Register is force written
+   */
+  bool _isForceWrite;
+
+  /**
+   * Resolved Registers pointers
+   * in group order
+   */
+  std::vector<TypedRegisterFloat*> _regsPosition;
+  std::vector<TypedRegisterFloat*> _regsSpeed;
+  std::vector<TypedRegisterFloat*> _regsLoad;
+  std::vector<TypedRegisterFloat*> _regsGoalPosition;
+
+  /**
+   * Structure of arrays values
+   */
+  std::vector<float> _positions;
+  std::vector<float> _speeds;
+  std::vector<float> _loads;
+  std::vector<float> _goalPositions;
+};
+
+}  // namespace RhAL
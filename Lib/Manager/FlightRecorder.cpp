@@ -0,0 +1,198 @@
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <stdexcept>
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "Manager/FlightRecorder.hpp"
+
+namespace RhAL
+{
+/**
+ * File magic
+ */
+static const char FlightRecorderMagic[8] = { 'R', 'H', 'A', 'L', 'F', 'R', 'E', 'C' };
+
+FlightRecorder::FlightRecorder()
+  : _fd(-1)
+  , _header(nullptr)
+  , _records(nullptr)
+  , _size(0)
+  , _capacity(0)
+  , _origin()
+{
+}
+
+FlightRecorder::~FlightRecorder()
+{
+  close();
+}
+
+void FlightRecorder::open(const std::string& path, size_t capacity, const TimePoint& origin)
+{
+  close();
+  if (capacity == 0)
+  {
+    throw std::logic_error("FlightRecorder zero capacity");
+  }
+  _fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (_fd < 0)
+  {
+    throw std::runtime_error("FlightRecorder unable to open file: " + path + ": " + std::strerror(errno));
+  }
+  _size = sizeof(FlightRecorderHeader) + capacity * sizeof(FlightRecord);
+  if (::ftruncate(_fd, _size) != 0)
+  {
+    int err = errno;
+    close();
+    throw std::runtime_error("FlightRecorder unable to resize file: " + path + ": " + std::strerror(err));
+  }
+  void* ptr = ::mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+  if (ptr == MAP_FAILED)
+  {
+    int err = errno;
+    close();
+    throw std::runtime_error("FlightRecorder unable to map file: " + path + ": " + std::strerror(err));
+  }
+  _header = (FlightRecorderHeader*)ptr;
+  _records = (FlightRecord*)((data_t*)ptr + sizeof(FlightRecorderHeader));
+  _capacity = capacity;
+  // Timestamps origin
+  _origin = origin;
+  std::memset(_header, 0, sizeof(FlightRecorderHeader));
+  std::memcpy(_header->magic, FlightRecorderMagic, sizeof(FlightRecorderMagic));
+  _header->version = FlightRecorderVersion;
+  _header->recordSize = sizeof(FlightRecord);
+  _header->capacity = _capacity;
+  _header->count = 0;
+  _header->originTime =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+          .count();
+}
+
+void FlightRecorder::close()
+{
+  if (_header != nullptr)
+  {
+    ::munmap(_header, _size);
+    _header = nullptr;
+    _records = nullptr;
+  }
+  if (_fd >= 0)
+  {
+    ::close(_fd);
+    _fd = -1;
+  }
+  _size = 0;
+  _capacity = 0;
+}
+
+bool FlightRecorder::isOpen() const
+{
+  return _header != nullptr;
+}
+
+void FlightRecorder::append(uint8_t type, unsigned long cycle, id_t id, addr_t addr, const data_t* data,
+                            size_t length, ResponseState state, const TimePoint& time,
+                            const TimeDurationMicro& duration)
+{
+  if (_header == nullptr)
+  {
+    return;
+  }
+  uint64_t t = std::chrono::duration_cast<std::chrono::nanoseconds>(time - _origin).count();
+  uint64_t count = _header->count;
+  size_t offset = 0;
+  // Split long transactions over
+  // several records
+  do
+  {
+    size_t len = std::min(length - offset, FlightRecordDataLen);
+    FlightRecord& record = _records[count % _capacity];
+    record.time = t;
+    record.cycle = cycle;
+    record.state = state;
+    record.type = type;
+    record.id = id;
+    record.addr = addr + offset;
+    record.length = len;
+    record.duration = duration.count();
+    std::memcpy(record.data, data + offset, len);
+    offset += len;
+    count++;
+  } while (offset < length);
+  // Publish the records to
+  // concurrent file readers
+  __atomic_store_n(&_header->count, count, __ATOMIC_RELEASE);
+}
+
+std::vector<FlightRecord> FlightRecorder::load(const std::string& path, FlightRecorderHeader& header)
+{
+  std::ifstream file(path, std::ios::in | std::ios::binary);
+  if (!file.is_open())
+  {
+    throw std::runtime_error("FlightRecorder unable to read file: " + path);
+  }
+  file.read((char*)&header, sizeof(FlightRecorderHeader));
+  if (!file || std::memcmp(header.magic, FlightRecorderMagic, sizeof(FlightRecorderMagic)) != 0 ||
+      header.version != FlightRecorderVersion || header.recordSize != sizeof(FlightRecord) || header.capacity == 0)
+  {
+    throw std::runtime_error("FlightRecorder malformed file: " + path);
+  }
+  std::vector<FlightRecord> slots(header.capacity);
+  file.read((char*)slots.data(), header.capacity * sizeof(FlightRecord));
+  if (!file)
+  {
+    throw std::runtime_error("FlightRecorder truncated file: " + path);
+  }
+  // Reorder from the oldest record
+  uint64_t begin = 0;
+  if (header.count > header.capacity)
+  {
+    begin = header.count - header.capacity;
+  }
+  std::vector<FlightRecord> records;
+  records.reserve(header.count - begin);
+  for (uint64_t i = begin; i < header.count; i++)
+  {
+    records.push_back(slots[i % header.capacity]);
+  }
+
+  return records;
+}
+
+std::vector<FlightTransaction> FlightRecorder::merge(const std::vector<FlightRecord>& records)
+{
+  std::vector<FlightTransaction> transactions;
+  for (const FlightRecord& rec : records)
+  {
+    if (!transactions.empty())
+    {
+      FlightTransaction& last = transactions.back();
+      bool isContinuation = rec.length > 0 && last.data.size() % FlightRecordDataLen == 0 &&
+                            last.time == rec.time && last.cycle == rec.cycle && last.type == rec.type &&
+                            last.id == rec.id && last.addr + last.data.size() == rec.addr;
+      if (isContinuation)
+      {
+        last.data.insert(last.data.end(), rec.data, rec.data + rec.length);
+        continue;
+      }
+    }
+    FlightTransaction transaction;
+    transaction.time = rec.time;
+    transaction.cycle = rec.cycle;
+    transaction.state = rec.state;
+    transaction.type = rec.type;
+    transaction.id = rec.id;
+    transaction.addr = rec.addr;
+    transaction.duration = rec.duration;
+    transaction.data.assign(rec.data, rec.data + rec.length);
+    transactions.push_back(transaction);
+  }
+
+  return transactions;
+}
+
+}  // namespace RhAL
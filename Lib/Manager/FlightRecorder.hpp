@@ -0,0 +1,203 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "types.h"
+#include "Protocol/Protocol.hpp"
+
+namespace RhAL
+{
+/**
+ * Flight recorder file format version
+ * and fixed records payload size
+ */
+constexpr uint32_t FlightRecorderVersion = 1;
+constexpr size_t FlightRecordDataLen = 40;
+
+/**
+ * FlightRecord type flags
+ */
+enum : uint8_t
+{
+  // Bytes written to the Device (else read)
+  FlightRecordWrite = 1,
+  // Transaction was a sync read/write
+  FlightRecordSync = 2,
+  // Forced immediate read/write (out of flush)
+  FlightRecordForced = 4,
+  // Ping without data (state is ResponseOK
+  // if answered, else ResponseQuiet)
+  FlightRecordPing = 8,
+};
+
+/**
+ * FlightRecorderHeader
+ *
+ * Fixed 64 bytes file header.
+ * Count is the total number of records
+ * ever appended: the record i is stored at
+ * slot i % capacity.
+ * OriginTime is the system clock time
+ * (nanoseconds since epoch) of records
+ * timestamps origin.
+ */
+struct FlightRecorderHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t recordSize;
+  uint64_t capacity;
+  uint64_t count;
+  int64_t originTime;
+  uint8_t reserved[24];
+};
+
+/**
+ * FlightRecord
+ *
+ * Fixed 64 bytes record holding the raw
+ * bytes exchanged with one Device during one
+ * batch transaction. Batches longer than
+ * FlightRecordDataLen are split into several
+ * records with increasing address.
+ * State is the Protocol ResponseState
+ * (0 if write is not checked).
+ */
+struct FlightRecord
+{
+  uint64_t time;
+  uint32_t cycle;
+  uint16_t state;
+  uint8_t type;
+  uint8_t id;
+  uint16_t addr;
+  uint16_t length;
+  uint32_t duration;
+  data_t data[FlightRecordDataLen];
+};
+
+/**
+ * FlightTransaction
+ *
+ * Raw bytes exchanged with one Device
+ * during one transaction (split records
+ * merged back) with its record fields.
+ */
+struct FlightTransaction
+{
+  uint64_t time;
+  uint32_t cycle;
+  uint16_t state;
+  uint8_t type;
+  id_t id;
+  addr_t addr;
+  uint32_t duration;
+  std::vector<data_t> data;
+};
+
+static_assert(sizeof(FlightRecorderHeader) == 64, "FlightRecorderHeader layout");
+static_assert(sizeof(FlightRecord) == 64, "FlightRecord layout");
+
+/**
+ * FlightRecorder
+ *
+ * Append only binary log of all bus
+ * transactions into a memory mapped ring
+ * buffer file. Appending is a copy into the
+ * mapping (no system call) and the oldest
+ * records are overwritten once full.
+ * The file can be read while being written.
+ * Not thread safe (the Manager appends
+ * under its bus mutex).
+ */
+class FlightRecorder
+{
+public:
+  /**
+   * Initialization (closed)
+   */
+  FlightRecorder();
+
+  /**
+   * Unmap and close the file
+   */
+  ~FlightRecorder();
+
+  /**
+   * Copy constructor and
+   * assignement are forbidden
+   */
+  FlightRecorder(const FlightRecorder&) = delete;
+  FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+  /**
+   * Create (or truncate) given file and
+   * map it with room for given number of records.
+   * Records time is relative to given origin
+   * (the current time of the recording clock).
+   * Throw std::runtime_error on system error.
+   */
+  void open(const std::string& path, size_t capacity, const TimePoint& origin);
+
+  /**
+   * Unmap and close the file
+   * (no effect if not opened)
+   */
+  void close();
+
+  /**
+   * Return true if the recorder
+   * is opened
+   */
+  bool isOpen() const;
+
+  /**
+   * Append the given raw bytes exchanged with
+   * Device id at given address, with flush
+   * cycle, type flags, response state,
+   * transaction end time and duration.
+   * No effect if not opened.
+   */
+  void append(uint8_t type, unsigned long cycle, id_t id, addr_t addr, const data_t* data, size_t length,
+              ResponseState state, const TimePoint& time, const TimeDurationMicro& duration);
+
+  /**
+   * Read all records currently stored in
+   * given file, from the oldest to the newest.
+   * Header is also returned.
+   * Throw std::runtime_error if the file
+   * cannot be read or is malformed.
+   */
+  static std::vector<FlightRecord> load(const std::string& path, FlightRecorderHeader& header);
+
+  /**
+   * Merge back continuation records of
+   * transactions longer than FlightRecordDataLen.
+   * Given records are expected ordered.
+   */
+  static std::vector<FlightTransaction> merge(const std::vector<FlightRecord>& records);
+
+private:
+  /**
+   * File descriptor, mapped
+   * header and records
+   */
+  int _fd;
+  FlightRecorderHeader* _header;
+  FlightRecord* _records;
+
+  /**
+   * Mapping length in bytes and
+   * number of records slots
+   */
+  size_t _size;
+  uint64_t _capacity;
+
+  /**
+   * Records timestamps origin
+   */
+  TimePoint _origin;
+};
+
+}  // namespace RhAL
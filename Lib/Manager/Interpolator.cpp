@@ -0,0 +1,184 @@
+#include <algorithm>
+#include "Interpolator.hpp"
+#include "Register.hpp"
+
+namespace RhAL
+{
+Interpolator::Interpolator()
+  : _mutex()
+  , _regs()
+  , _startTimes()
+  , _invDurations()
+  , _starts()
+  , _k1()
+  , _k2()
+  , _k3()
+  , _k4()
+  , _k5()
+  , _results()
+  , _values()
+  , _times()
+{
+}
+
+void Interpolator::start(TypedRegister<float>& reg, float startValue, float endValue, double duration,
+                         const TimePoint& now, InterpolationProfile profile)
+{
+  if (duration < 0.001)
+  {
+    duration = 0.001;
+  }
+  // Profile polynomial coefficients
+  double delta = endValue - startValue;
+  double k[5] = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+  if (profile == InterpolationLinear)
+  {
+    k[0] = delta;
+  }
+  else if (profile == InterpolationCubic)
+  {
+    k[1] = 3.0 * delta;
+    k[2] = -2.0 * delta;
+  }
+  else
+  {
+    k[2] = 10.0 * delta;
+    k[3] = -15.0 * delta;
+    k[4] = 6.0 * delta;
+  }
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  long index = find(&reg);
+  if (index < 0)
+  {
+    index = _regs.size();
+    _regs.push_back(&reg);
+    _startTimes.push_back(0.0);
+    _invDurations.push_back(0.0);
+    _starts.push_back(0.0);
+    _k1.push_back(0.0);
+    _k2.push_back(0.0);
+    _k3.push_back(0.0);
+    _k4.push_back(0.0);
+    _k5.push_back(0.0);
+  }
+  _startTimes[index] = duration_float(now);
+  _invDurations[index] = 1.0 / duration;
+  _starts[index] = startValue;
+  _k1[index] = k[0];
+  _k2[index] = k[1];
+  _k3[index] = k[2];
+  _k4[index] = k[3];
+  _k5[index] = k[4];
+}
+
+void Interpolator::stop(const TypedRegister<float>& reg)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  long index = find(&reg);
+  if (index >= 0)
+  {
+    remove(index);
+  }
+}
+
+bool Interpolator::isActive(const TypedRegister<float>& reg) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return find(&reg) >= 0;
+}
+
+size_t Interpolator::count() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _regs.size();
+}
+
+void Interpolator::update(const TimePoint& now)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  size_t size = _regs.size();
+  if (size == 0)
+  {
+    return;
+  }
+  _results.resize(size);
+  _values.resize(size);
+  _times.resize(size);
+  const double time = duration_float(now);
+  const double* __restrict startTimes = _startTimes.data();
+  const double* __restrict invDurations = _invDurations.data();
+  const double* __restrict starts = _starts.data();
+  const double* __restrict k1 = _k1.data();
+  const double* __restrict k2 = _k2.data();
+  const double* __restrict k3 = _k3.data();
+  const double* __restrict k4 = _k4.data();
+  const double* __restrict k5 = _k5.data();
+  double* __restrict times = _times.data();
+  double* __restrict results = _results.data();
+  // Branchless evaluation of all interpolations,
+  // in double only so that the loop is a single
+  // SIMD pass (see -fopenmp-simd in CMakeLists.txt)
+#pragma omp simd
+  for (size_t i = 0; i < size; i++)
+  {
+    double s = (time - startTimes[i]) * invDurations[i];
+    s = s < 0.0 ? 0.0 : s;
+    s = s > 1.0 ? 1.0 : s;
+    times[i] = s;
+    results[i] = starts[i] + s * (k1[i] + s * (k2[i] + s * (k3[i] + s * (k4[i] + s * k5[i]))));
+  }
+  // Conversion for the Registers bulk write
+  float* __restrict values = _values.data();
+#pragma omp simd
+  for (size_t i = 0; i < size; i++)
+  {
+    values[i] = results[i];
+  }
+  TypedRegister<float>::writeValues(_regs.data(), values, size, now);
+  // Remove finished interpolations
+  for (size_t i = size; i > 0; i--)
+  {
+    if (times[i - 1] >= 1.0)
+    {
+      remove(i - 1);
+    }
+  }
+}
+
+long Interpolator::find(const TypedRegister<float>* reg) const
+{
+  for (size_t i = 0; i < _regs.size(); i++)
+  {
+    if (_regs[i] == reg)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void Interpolator::remove(size_t index)
+{
+  size_t last = _regs.size() - 1;
+  _regs[index] = _regs[last];
+  _startTimes[index] = _startTimes[last];
+  _invDurations[index] = _invDurations[last];
+  _starts[index] = _starts[last];
+  _k1[index] = _k1[last];
+  _k2[index] = _k2[last];
+  _k3[index] = _k3[last];
+  _k4[index] = _k4[last];
+  _k5[index] = _k5[last];
+  _regs.pop_back();
+  _startTimes.pop_back();
+  _invDurations.pop_back();
+  _starts.pop_back();
+  _k1.pop_back();
+  _k2.pop_back();
+  _k3.pop_back();
+  _k4.pop_back();
+  _k5.pop_back();
+}
+
+}  // namespace RhAL
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include "types.h"
+
+namespace RhAL
+{
+// Forward declaration
+template <typename T>
+class TypedRegister;
+
+/**
+ * Interpolation profile shape
+ * between start and end values
+ */
+enum InterpolationProfile
+{
+  // Constant velocity
+  InterpolationLinear,
+  // Cubic with zero end velocities
+  InterpolationCubic,
+  // Quintic with zero end
+  // velocities and accelerations
+  InterpolationMinimumJerk,
+};
+
+/**
+ * Interpolator
+ *
+ * Manager level engine moving float
+ * Registers (typically goal positions) from
+ * a start to an end value over a duration.
+ * All active interpolations are stored as
+ * structure of arrays and evaluated together
+ * at each flush by a branchless double loop
+ * (every profile is a polynomial of normalized
+ * time with per interpolation coefficients)
+ * marked as OpenMP SIMD, vectorized when built
+ * with optimizations (-O2 and above).
+ * Results are written with TypedRegister
+ * bulk write.
+ * Thread safe.
+ */
+class Interpolator
+{
+public:
+  /**
+   * Initialization
+   */
+  Interpolator();
+
+  /**
+   * Start (or restart) the interpolation
+   * of given Register from start to end value
+   * over given duration in seconds with given
+   * profile. Values are written from next flush.
+   */
+  void start(TypedRegister<float>& reg, float startValue, float endValue, double duration, const TimePoint& now,
+             InterpolationProfile profile = InterpolationLinear);
+
+  /**
+   * Stop the interpolation of given
+   * Register (current value is kept)
+   */
+  void stop(const TypedRegister<float>& reg);
+
+  /**
+   * Return true if given Register
+   * is currently interpolated
+   */
+  bool isActive(const TypedRegister<float>& reg) const;
+
+  /**
+   * Return the number of
+   * active interpolations
+   */
+  size_t count() const;
+
+  /**
+   * Evaluate all active interpolations
+   * at given time, mark the Registers to
+   * be written and remove finished ones.
+   * Called by the Manager at each flush.
+   */
+  void update(const TimePoint& now);
+
+private:
+  /**
+   * Mutex protecting arrays
+   */
+  mutable std::mutex _mutex;
+
+  /**
+   * Structure of arrays interpolation
+   * states. The value is
+   * start + k1.s + k2.s^2 + ... + k5.s^5
+   * with s the normalized time in [0:1].
+   */
+  std::vector<TypedRegister<float>*> _regs;
+  std::vector<double> _startTimes;
+  std::vector<double> _invDurations;
+  std::vector<double> _starts;
+  std::vector<double> _k1;
+  std::vector<double> _k2;
+  std::vector<double> _k3;
+  std::vector<double> _k4;
+  std::vector<double> _k5;
+
+  /**
+   * Evaluation buffers
+   */
+  std::vector<double> _results;
+  std::vector<float> _values;
+  std::vector<double> _times;
+
+  /**
+   * Return the index of given
+   * Register or -1
+   */
+  long find(const TypedRegister<float>* reg) const;
+
+  /**
+   * Remove the interpolation at given
+   * index (swapped with the last one)
+   */
+  void remove(size_t index);
+};
+
+}  // namespace RhAL
@@ -31,6 +31,9 @@ public:
   inline ~Manager()
   {
     stopManagerThread();
+    // Run remaining read callbacks
+    // while Devices are still alive
+    this->callbackExecutor().stop();
   }
 
   /**
@@ -49,24 +52,36 @@ public:
   /**
    * Import from given json object all
    * Parameters and derived Devices configuration.
+   * The reload is incremental: the Bus and
+   * Protocol are only reopened if the port, baudrate,
+   * protocol or capture changed, other Parameters
+   * are applied in place between two flushes.
    * Throw std::runtime_error if
    * given json is malformated.
    */
   inline virtual void loadJSON(const Json::Value& j) override
   {
-    std::lock_guard<std::mutex> lock(CallManager::_mutex);
+    // Check format and find changed
+    // subsystems before locking
     if (!j.isObject() || j.size() > sizeof...(Types) + 1 || j["Manager"].isNull() || j["Protocol"].isNull())
     {
       throw std::runtime_error("Manager load parameters root json malformed");
     }
-    // Load Devices parameters
-    this->loadAggregatedJSON(j);
-    // Load Manager parameters (bus/protocol)
-    this->_parametersList.loadJSON(j["Manager"]);
-    // Reset low level communication (bus/protocol)
-    this->initBus();
-    // Load specific Protocol parameters
-    this->protocolParametersList().loadJSON(j["Protocol"]);
+    BaseManager::ParametersReload reload = this->diffParametersJSON(j["Manager"]);
+    {
+      std::lock_guard<std::mutex> lock(CallManager::_mutex);
+      // Load Devices parameters
+      this->loadAggregatedJSON(j);
+      // Load Manager and Protocol parameters
+      // and reset changed subsystems (bus/protocol,
+      // flight recorder)
+      this->reloadParametersJSON(j["Manager"], j["Protocol"], reload);
+    }
+    // Callbacks workers are joined unlocked
+    if (reload.isExecutorReset)
+    {
+      this->initCallbackExecutor();
+    }
   }
 
   /**
@@ -129,7 +129,7 @@ Json::Value ParametersList::saveJSON() const
   return j;
 }
 
-void ParametersList::loadJSON(const Json::Value& j)
+void ParametersList::checkJSON(const Json::Value& j) const
 {
   // Empty case
   if (j.isNull())
@@ -153,10 +153,6 @@ void ParametersList::loadJSON(const Json::Value& j)
       {
         throw std::runtime_error("ParametersContainer load parameters json bool does not exist: " + key);
       }
-      else
-      {
-        paramBool(key).value = v.asBool();
-      }
     }
     else if (v.isDouble())
     {
@@ -165,10 +161,6 @@ void ParametersList::loadJSON(const Json::Value& j)
       {
         throw std::runtime_error("ParametersContainer load parameters json number does not exist: " + key);
       }
-      else
-      {
-        paramNumber(key).value = v.asDouble();
-      }
     }
     else if (v.isString())
     {
@@ -178,10 +170,6 @@ void ParametersList::loadJSON(const Json::Value& j)
         throw std::runtime_error("ParametersContainer load parameters json str does not exist: " + key +
                                  " with value: " + v.asString());
       }
-      else
-      {
-        paramStr(key).value = v.asString();
-      }
     }
     else
     {
@@ -190,4 +178,33 @@ void ParametersList::loadJSON(const Json::Value& j)
   }
 }
 
+void ParametersList::loadJSON(const Json::Value& j)
+{
+  // Check the whole json before
+  // assigning any parameter
+  checkJSON(j);
+  if (j.isNull())
+  {
+    return;
+  }
+  // Iterate on json entries
+  for (Json::Value::const_iterator it = j.begin(); it != j.end(); it++)
+  {
+    const std::string& key = it.name();
+    const Json::Value& v = j[key];
+    if (v.isBool())
+    {
+      paramBool(key).value = v.asBool();
+    }
+    else if (v.isDouble())
+    {
+      paramNumber(key).value = v.asDouble();
+    }
+    else
+    {
+      paramStr(key).value = v.asString();
+    }
+  }
+}
+
 }  // namespace RhAL
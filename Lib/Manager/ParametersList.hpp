@@ -72,9 +72,17 @@ public:
   Json::Value saveJSON() const;
 
   /**
-   * Import parameters from given json object.
+   * Check that given json object only holds
+   * existing parameters with matching types.
    * Throw std::runtime_error if given json is malformated.
    */
+  void checkJSON(const Json::Value& j) const;
+
+  /**
+   * Import parameters from given json object.
+   * Nothing is assigned if given json is malformated
+   * and std::runtime_error is thrown.
+   */
   void loadJSON(const Json::Value& j);
 
 private:
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include "Register.hpp"
 #include "CallManager.hpp"
 
@@ -27,10 +28,12 @@ Register::Register(const std::string& name, addr_t addr, size_t length, unsigned
   , _isLastWriteError(false)
   , _manager(nullptr)
   , _mutex()
+  , _isCallbackPending(false)
+  , _isWriteAccumulated(false)
 {
-  if (length > MaxRegisterLength)
+  if (length == 0)
   {
-    throw std::logic_error("Register length invalid with static max length: " + name);
+    throw std::logic_error("Register null length: " + name);
   }
   if (addr + length >= AddrDevLen)
   {
@@ -90,12 +93,13 @@ bool Register::needRead() const
 bool Register::needWrite() const
 {
   std::lock_guard<std::mutex> lock(_mutex);
-  return _needWrite;
+  return _needWrite || _isWriteAccumulated.load(std::memory_order_acquire);
 }
 
 void Register::selectForWrite()
 {
   std::lock_guard<std::mutex> lock(_mutex);
+  doMergeWrite();
   doConvEncode();
   _needWrite = false;
   _isLastWriteError = false;
@@ -141,23 +145,46 @@ void Register::swapRead()
   _lastDevReadUser = _lastDevReadManager;
 }
 
+size_t Register::threadWriteAccumulator()
+{
+  static std::atomic<size_t> counter(0);
+  static thread_local size_t index = counter.fetch_add(1, std::memory_order_relaxed) % WriteAccumulatorsCount;
+  return index;
+}
+
+void Register::snapshot(SnapshotEntry& entry) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  entry.id = id;
+  entry.addr = addr;
+  entry.reg = this;
+  entry.value = doReadNumber();
+  entry.timestamp = _lastDevReadUser;
+  entry.isError = _isLastReadError;
+}
+
 template <typename T>
 TypedRegister<T>::TypedRegister(const std::string& name, addr_t addr, size_t length, FuncConvEncode<T> funcConvEncode,
                                 FuncConvDecode<T> funcConvDecode, unsigned int periodPackedRead, bool forceRead,
-                                bool forceWrite, bool isSlowRegister)
+                                bool forceWrite, bool isSlowRegister, bool isReadOnly)
   :  // Member init
-  Register(name, addr, length, periodPackedRead, forceRead, forceWrite, isSlowRegister)
+  Register(name, addr, length, periodPackedRead, forceRead, forceWrite, isSlowRegister, isReadOnly)
   , funcConvEncode(funcConvEncode)
   , funcConvDecode(funcConvDecode)
-  , _minValue(T(0))
-  , _maxValue(T(0))
-  , _stepValue(T(0))
   , _valueRead()
   , _valueWrite()
-  , _aggregationPolicy(AggregateLast)
   , _callbackOnRead([](T val) { (void)val; })
   , _callbackOnWrite([](T val) { (void)val; })
+  , _minValue(T(0))
+  , _maxValue(T(0))
+  , _stepValue(T(0))
+  , _aggregationPolicy(AggregateLast)
+  , _writeAccumulators()
 {
+  if (length > MaxRegisterLength)
+  {
+    throw std::logic_error("TypedRegister length invalid with static max length: " + name);
+  }
 }
 
 template <typename T>
@@ -167,15 +194,20 @@ TypedRegister<T>::TypedRegister(const std::string& name, addr_t addr, size_t len
   Register(name, addr, length, periodPackedRead, forceRead, forceWrite, isSlowRegister, true)
   , funcConvEncode()
   , funcConvDecode(funcConvDecode)
-  , _minValue(T(0))
-  , _maxValue(T(0))
-  , _stepValue(T(0))
   , _valueRead()
   , _valueWrite()
-  , _aggregationPolicy(AggregateLast)
   , _callbackOnRead([](T val) { (void)val; })
   , _callbackOnWrite([](T val) { (void)val; })
+  , _minValue(T(0))
+  , _maxValue(T(0))
+  , _stepValue(T(0))
+  , _aggregationPolicy(AggregateLast)
+  , _writeAccumulators()
 {
+  if (length > MaxRegisterLength)
+  {
+    throw std::logic_error("TypedRegister length invalid with static max length: " + name);
+  }
 }
 
 template <typename T>
@@ -223,6 +255,24 @@ void TypedRegister<T>::setAggregationPolicy(AggregationPolicy policy)
   _aggregationPolicy = policy;
 }
 
+template <typename T>
+void TypedRegister<T>::enableWriteAccumulators()
+{
+  if (isReadOnly)
+  {
+    throw std::logic_error("TypedRegister write accumulators on read only Register: " + name);
+  }
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_writeAccumulators == nullptr)
+  {
+    _writeAccumulators.reset(new WriteAccumulator[WriteAccumulatorsCount]);
+    for (size_t i = 0; i < WriteAccumulatorsCount; i++)
+    {
+      _writeAccumulators[i].isSet = false;
+    }
+  }
+}
+
 template <typename T>
 void TypedRegister<T>::setCallbackRead(std::function<void(T)> func)
 {
@@ -237,12 +287,12 @@ void TypedRegister<T>::setCallbackWrite(std::function<void(T)> func)
 }
 
 template <typename T>
-ReadValue<T> TypedRegister<T>::readValue()
+ReadValue<T> TypedRegister<T>::readValue(bool noForceRead)
 {
   // Do immediate read on the bus
   // is the register is configured to forceWrite
   // or given Manager send mode
-  if (isForceRead || !_manager->isScheduleMode())
+  if (!noForceRead && (isForceRead || !_manager->isScheduleMode()))
   {
     forceRead();
   }
@@ -259,6 +309,45 @@ void TypedRegister<T>::writeValue(T val, bool noCallback)
     throw std::logic_error("TypedRegister write to read only Register: " + name);
   }
 
+  // Aggregate into the calling thread
+  // accumulator without Register mutex
+  if (_writeAccumulators != nullptr)
+  {
+    TimePoint timestamp = (_manager != nullptr) ? _manager->clock().now() : getTimePoint();
+    WriteAccumulator& accu = _writeAccumulators[threadWriteAccumulator()];
+    T value;
+    {
+      std::lock_guard<std::mutex> lockAccu(accu.mutex);
+      if (accu.isSet)
+      {
+        accu.value = aggregateValue(_aggregationPolicy, accu.value, val);
+      }
+      else
+      {
+        accu.value = val;
+        accu.first = timestamp;
+        accu.isSet = true;
+      }
+      accu.last = timestamp;
+      value = accu.value;
+    }
+    // Only store if not already set to keep
+    // the flag cache line shared
+    if (!_isWriteAccumulated.load(std::memory_order_relaxed))
+    {
+      _isWriteAccumulated.store(true, std::memory_order_release);
+    }
+    if (!noCallback)
+    {
+      _callbackOnWrite(value);
+    }
+    if (isForceWrite || !_manager->isScheduleMode())
+    {
+      forceWrite();
+    }
+    return;
+  }
+
   std::unique_lock<std::mutex> lock(_mutex);
 
   // Compute aggregation if the value
@@ -274,7 +363,7 @@ void TypedRegister<T>::writeValue(T val, bool noCallback)
     _valueWrite = val;
   }
   // Assign the timestamp
-  _lastUserWrite = getTimePoint();
+  _lastUserWrite = (_manager != nullptr) ? _manager->clock().now() : getTimePoint();
   // Mark as dirty
   _needWrite = true;
   // Call user callback
@@ -293,6 +382,42 @@ void TypedRegister<T>::writeValue(T val, bool noCallback)
   }
 }
 
+template <typename T>
+void TypedRegister<T>::writeValues(TypedRegister<T>* const* regs, const T* values, size_t count,
+                                   const TimePoint& timestamp)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    TypedRegister<T>& reg = *regs[i];
+    if (reg.isReadOnly)
+    {
+      throw std::logic_error("TypedRegister write to read only Register: " + reg.name);
+    }
+    std::lock_guard<std::mutex> lock(reg._mutex);
+    if (reg._needWrite && !reg._isLastWriteError)
+    {
+      reg._valueWrite = aggregateValue(reg._aggregationPolicy, reg._valueWrite, values[i]);
+    }
+    else
+    {
+      reg._valueWrite = values[i];
+    }
+    reg._lastUserWrite = timestamp;
+    reg._needWrite = true;
+    reg._callbackOnWrite(reg._valueWrite);
+  }
+}
+
+template <typename T>
+void TypedRegister<T>::readValues(TypedRegister<T>* const* regs, T* values, size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    std::lock_guard<std::mutex> lock(regs[i]->_mutex);
+    values[i] = regs[i]->_valueRead;
+  }
+}
+
 template <typename T>
 T TypedRegister<T>::getWrittenValue() const
 {
@@ -338,12 +463,120 @@ void TypedRegister<T>::doConvEncode()
   }
   funcConvEncode(_dataBufferWrite, _valueWrite);
 }
+template <typename T>
+void TypedRegister<T>::doMergeWrite()
+{
+  if (_writeAccumulators == nullptr || !_isWriteAccumulated.exchange(false, std::memory_order_acq_rel))
+  {
+    return;
+  }
+  // Collect and reset set accumulators
+  struct Entry
+  {
+    T value;
+    TimePoint first;
+    TimePoint last;
+  };
+  Entry entries[WriteAccumulatorsCount + 1];
+  size_t count = 0;
+  for (size_t i = 0; i < WriteAccumulatorsCount; i++)
+  {
+    WriteAccumulator& accu = _writeAccumulators[i];
+    std::lock_guard<std::mutex> lockAccu(accu.mutex);
+    if (accu.isSet)
+    {
+      entries[count++] = Entry{ accu.value, accu.first, accu.last };
+      accu.isSet = false;
+    }
+  }
+  if (count == 0)
+  {
+    return;
+  }
+  // Include the not yet sent value
+  // (replaced after a write error)
+  if (_needWrite && !_isLastWriteError)
+  {
+    entries[count++] = Entry{ _valueWrite, _lastUserWrite, _lastUserWrite };
+  }
+  // Merge in write order with
+  // the aggregation policy
+  bool isLast = (_aggregationPolicy == AggregateLast);
+  std::sort(entries, entries + count, [isLast](const Entry& e1, const Entry& e2) -> bool {
+    return isLast ? e1.last < e2.last : e1.first < e2.first;
+  });
+  T value = entries[0].value;
+  TimePoint timestamp = entries[0].last;
+  for (size_t i = 1; i < count; i++)
+  {
+    value = aggregateValue(_aggregationPolicy, value, entries[i].value);
+    timestamp = std::max(timestamp, entries[i].last);
+  }
+  _valueWrite = value;
+  _lastUserWrite = timestamp;
+  _needWrite = true;
+}
+
 template <typename T>
 void TypedRegister<T>::doConvDecode()
 {
   _valueRead = funcConvDecode(_dataBufferRead);
-  // Call user callback
-  _callbackOnRead(_valueRead);
+  // Call or queue user callback
+  dispatchCallbackRead();
+}
+
+template <typename T>
+double TypedRegister<T>::decodeNumber(const data_t* data) const
+{
+  return (double)funcConvDecode(data);
+}
+
+template <typename T>
+double TypedRegister<T>::doReadNumber() const
+{
+  return (double)_valueRead;
+}
+
+template <typename T>
+void TypedRegister<T>::runCallbackRead(const CallbackTask& task)
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  T value = task.isCoalesced ? _valueRead : (T)task.value;
+  // Newer decoded values can be queued again
+  _isCallbackPending = false;
+  std::function<void(T)> callback = _callbackOnRead;
+  lock.unlock();
+  callback(value);
+}
+
+template <typename T>
+void TypedRegister<T>::dispatchCallbackRead()
+{
+  CallbackExecutor* executor = (_manager != nullptr) ? &_manager->callbackExecutor() : nullptr;
+  if (executor == nullptr || !executor->isEnabled())
+  {
+    _callbackOnRead(_valueRead);
+    return;
+  }
+  if (executor->isCoalescing())
+  {
+    // Already queued callback will
+    // deliver the latest value
+    if (_isCallbackPending)
+    {
+      return;
+    }
+    _isCallbackPending = true;
+    if (!executor->push(CallbackTask{ this, 0.0, true }))
+    {
+      _isCallbackPending = false;
+      _callbackOnRead(_valueRead);
+    }
+  }
+  else if (!executor->push(CallbackTask{ this, (double)_valueRead, false }))
+  {
+    _callbackOnRead(_valueRead);
+  }
 }
 
 // Template explicite instantiation
@@ -3,9 +3,13 @@
 #include <functional>
 #include <stdexcept>
 #include <mutex>
+#include <atomic>
+#include <memory>
 #include "types.h"
 #include "timestamp.h"
 #include "Aggregation.h"
+#include "Snapshot.hpp"
+#include "CallbackExecutor.hpp"
 
 namespace RhAL
 {
@@ -14,11 +18,19 @@ class CallManager;
 
 /**
  * Compile time constante for
- * register data buffer maximum
- * length in bytes
+ * typed register data buffer maximum
+ * length in bytes (see BlockRegister
+ * for longer registers)
  */
 constexpr size_t MaxRegisterLength = 4;
 
+/**
+ * Compile time constante for the number
+ * of per thread write accumulators of
+ * TypedRegister (see enableWriteAccumulators())
+ */
+constexpr size_t WriteAccumulatorsCount = 8;
+
 /**
  * Template alias for conversion function
  * from value to raw data buffer and inverse
@@ -139,10 +151,20 @@ public:
   /**
    * Return true if the register
    * has been mark to be Read or Write
+   * (or has pending accumulated writes)
    */
   bool needRead() const;
   bool needWrite() const;
 
+  /**
+   * Convert given raw data buffer (register
+   * length bytes) into a value as double using
+   * the Register decode function.
+   * Register state is not modified.
+   * (Used to decode recorded bus traffic)
+   */
+  virtual double decodeNumber(const data_t* data) const = 0;
+
 protected:
   /**
    * Raw data buffer pointer in
@@ -210,6 +232,19 @@ protected:
    */
   mutable std::mutex _mutex;
 
+  /**
+   * True while a coalesced read callback
+   * is queued in the callback executor
+   */
+  std::atomic<bool> _isCallbackPending;
+
+  /**
+   * True if values have been written
+   * in write accumulators and not yet
+   * merged (set without Register mutex)
+   */
+  std::atomic<bool> _isWriteAccumulated;
+
   /**
    * Request conversion by derived TypedRegister
    * from typed written value to data buffer and from
@@ -219,15 +254,53 @@ protected:
   virtual void doConvEncode() = 0;
   virtual void doConvDecode() = 0;
 
+  /**
+   * Merge pending write accumulators
+   * into the typed written value.
+   * No thread protection.
+   */
+  virtual inline void doMergeWrite()
+  {
+    // Empty default
+  }
+
+  /**
+   * Return the write accumulator
+   * index of calling thread
+   */
+  static size_t threadWriteAccumulator();
+
+  /**
+   * Return current typed read
+   * value converted to double.
+   * No thread protection.
+   */
+  virtual double doReadNumber() const = 0;
+
+  /**
+   * Run the user read callback for given
+   * task queued in the callback executor.
+   * Thread safe (the callback itself is
+   * called without holding the Register mutex).
+   */
+  virtual void runCallbackRead(const CallbackTask& task) = 0;
+
   /**
    * Manager has access to
    * private members
    */
   friend class BaseManager;
 
+  /**
+   * Callback executor
+   * runs queued callbacks
+   */
+  friend class CallbackExecutor;
+
   /**
    * Mark the register as selected for write.
-   * Current write typed value is converted into
+   * Pending write accumulators are merged and
+   * current write typed value is converted into
    * the write data buffer.
    * Set needWrite to false.
    * (Call by Manager)
@@ -272,6 +345,13 @@ protected:
    * (Call by Manager)
    */
   void swapRead();
+
+  /**
+   * Fill given snapshot entry with current
+   * read value, timestamp and error flag.
+   * (Call by Manager)
+   */
+  void snapshot(SnapshotEntry& entry) const;
 };
 
 /**
@@ -305,10 +385,12 @@ public:
    * from typed value to data buffer.
    * funcConvDecode: convertion function
    * from data buffer to typed value.
+   * isReadOnly: if true, funcConvEncode
+   * may be empty and is never called.
    */
   TypedRegister(const std::string& name, addr_t addr, size_t length, FuncConvEncode<T> funcConvEncode,
                 FuncConvDecode<T> funcConvDecode, unsigned int periodPackedRead = 0, bool forceRead = false,
-                bool forceWrite = false, bool isSlowRegister = false);
+                bool forceWrite = false, bool isSlowRegister = false, bool isReadOnly = false);
 
   /**
    * Initialization for ReadOnly Register and
@@ -339,6 +421,24 @@ public:
    */
   void setAggregationPolicy(AggregationPolicy policy);
 
+  /**
+   * Enable per thread write accumulators.
+   * writeValue() then aggregates into the
+   * accumulator of the calling thread without
+   * taking the Register mutex, and accumulators
+   * are merged with the aggregation policy only
+   * when the Manager selects the Register for
+   * write (First and Last are ordered by write
+   * timestamp). The write callback is given the
+   * calling thread aggregated value and
+   * getWrittenValue() does not include values
+   * not yet merged.
+   * Has to be called (after the aggregation policy
+   * and write callback are set) before concurrent
+   * writes begin.
+   */
+  void enableWriteAccumulators();
+
   /**
    * Set the on user write and on
    * manager read callback. The updated
@@ -351,8 +451,11 @@ public:
    * Return the last read value from
    * the hardware. The returned timestamp
    * is the time when data are received from the bus.
+   * If noForceRead is true, no immediate read
+   * is done on the bus and the value decoded
+   * during last flush is returned.
    */
-  ReadValue<T> readValue();
+  ReadValue<T> readValue(bool noForceRead = false);
 
   /**
    * Set the current contained typed value.
@@ -365,6 +468,26 @@ public:
    */
   void writeValue(T val, bool noCallback = false);
 
+  /**
+   * Bulk write of given values to given Registers
+   * with one shared user write timestamp.
+   * Same as writeValue() on each Register except
+   * that no immediate write is ever done (the
+   * Registers are only marked to be written).
+   * Used by the Manager during flush and
+   * by DeviceGroup.
+   */
+  static void writeValues(TypedRegister<T>* const* regs, const T* values, size_t count, const TimePoint& timestamp);
+
+  /**
+   * Bulk read of the last read values of
+   * given Registers into given values array.
+   * Same as readValue(true) on each Register
+   * (no immediate read is ever done).
+   * Used by DeviceGroup.
+   */
+  static void readValues(TypedRegister<T>* const* regs, T* values, size_t count);
+
   /**
    * Return the current write value
    * that has been written by writeValue()
@@ -387,6 +510,11 @@ public:
   void operator=(const T& val);
   operator T();
 
+  /**
+   * Inherit.
+   */
+  virtual double decodeNumber(const data_t* data) const override;
+
 protected:
   /**
    * Inherit.
@@ -397,18 +525,16 @@ protected:
    */
   virtual void doConvEncode() override;
   virtual void doConvDecode() override;
+  virtual double doReadNumber() const override;
+  virtual void runCallbackRead(const CallbackTask& task) override;
 
-private:
   /**
-   * Additional optional range values and minimum
-   * step value for the register.
-   * Useful mainly for the Float Register type.
-   * The values are supposed non defined if they are
-   * all equals to 0 (T(0)).
+   * Call the user read callback with current
+   * read value or queue it to the callback
+   * executor if enabled.
+   * Register mutex is supposed to be held.
    */
-  T _minValue;
-  T _maxValue;
-  T _stepValue;
+  void dispatchCallbackRead();
 
   /**
    * Typed Register value.
@@ -421,11 +547,6 @@ private:
   T _valueRead;
   T _valueWrite;
 
-  /**
-   * Value Aggregation policy
-   */
-  AggregationPolicy _aggregationPolicy;
-
   /**
    * User callback called on user write
    * and on successfull manager read
@@ -435,6 +556,47 @@ private:
    */
   std::function<void(T)> _callbackOnRead;
   std::function<void(T)> _callbackOnWrite;
+
+private:
+  /**
+   * Additional optional range values and minimum
+   * step value for the register.
+   * Useful mainly for the Float Register type.
+   * The values are supposed non defined if they are
+   * all equals to 0 (T(0)).
+   */
+  T _minValue;
+  T _maxValue;
+  T _stepValue;
+
+  /**
+   * Value Aggregation policy
+   */
+  AggregationPolicy _aggregationPolicy;
+
+  /**
+   * Per thread write accumulator
+   * (on its own cache line)
+   */
+  struct alignas(64) WriteAccumulator
+  {
+    std::mutex mutex;
+    bool isSet;
+    T value;
+    TimePoint first;
+    TimePoint last;
+  };
+
+  /**
+   * Write accumulators array
+   * (null if not enabled)
+   */
+  std::unique_ptr<WriteAccumulator[]> _writeAccumulators;
+
+  /**
+   * Inherit.
+   */
+  virtual void doMergeWrite() override;
 };
 
 /**
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+#include "Manager/Register.hpp"
+
+namespace RhAL
+{
+/**
+ * Calibration
+ *
+ * Device angular convention (zero offset
+ * and inversion) snapshot. Plain old data
+ * so that it can be published atomically
+ * and read by conversions without any lock.
+ */
+struct Calibration
+{
+  float zero;
+  bool inverted;
+};
+
+/**
+ * Atomically updated calibration snapshot.
+ * Written by the Device on parameters change,
+ * read by its DescribedRegister on each conversion.
+ */
+typedef std::atomic<Calibration> AtomicCalibration;
+
+/**
+ * Calibration policy applied on top
+ * of the raw register conversion
+ */
+enum CalibrationPolicy : int
+{
+  // Raw conversion only
+  CalibrationNone = 0,
+  // Inversion flips the value sign (speed, acceleration, torque)
+  CalibrationDirection = 1,
+  // Zero offset then inversion (angular position)
+  CalibrationPosition = 2,
+};
+
+/**
+ * ConvFunctions
+ *
+ * Raw conversion from free functions given
+ * as template parameters so that the compiler
+ * can inline them. A null Encode function
+ * declares a read only register.
+ */
+template <void (*Encode)(data_t*, float), float (*Decode)(const data_t*)>
+struct ConvFunctions
+{
+  static constexpr bool isReadOnly = (Encode == nullptr);
+
+  static inline void encode(data_t* buffer, float value)
+  {
+    static_assert(Encode != nullptr, "ConvFunctions encode on read only conversion");
+    Encode(buffer, value);
+  }
+  static inline float decode(const data_t* buffer)
+  {
+    return Decode(buffer);
+  }
+};
+
+/**
+ * RegisterDescriptor
+ *
+ * Compile time description of a calibrated
+ * float register: address, length, raw conversion,
+ * calibration policy and constant angular Offset
+ * (added to the zero for Position policy).
+ */
+template <addr_t Addr, size_t Length, typename Conv, CalibrationPolicy Policy, int Offset = 0>
+struct RegisterDescriptor
+{
+  static_assert(Length <= MaxRegisterLength, "RegisterDescriptor length exceeds MaxRegisterLength");
+  static_assert(Policy == CalibrationPosition || Offset == 0, "RegisterDescriptor offset requires Position policy");
+
+  static constexpr addr_t addr = Addr;
+  static constexpr size_t length = Length;
+  static constexpr bool isReadOnly = Conv::isReadOnly;
+
+  /**
+   * Calibrate and encode given user value
+   */
+  static inline void encode(data_t* buffer, float value, const Calibration& calibration)
+  {
+    if (Policy == CalibrationPosition)
+    {
+      value = value + calibration.zero + Offset;
+    }
+    if (Policy != CalibrationNone && calibration.inverted)
+    {
+      value = -value;
+    }
+    Conv::encode(buffer, value);
+  }
+
+  /**
+   * Decode and uncalibrate to user value.
+   * Exact inverse of encode().
+   */
+  static inline float decode(const data_t* buffer, const Calibration& calibration)
+  {
+    float value = Conv::decode(buffer);
+    if (Policy != CalibrationNone && calibration.inverted)
+    {
+      value = -value;
+    }
+    if (Policy == CalibrationPosition)
+    {
+      value = value - calibration.zero - Offset;
+    }
+    return value;
+  }
+
+  /**
+   * Type erased conversion bound to given
+   * calibration snapshot (for TypedRegister
+   * public conversion functions)
+   */
+  static FuncConvEncode<float> encoder(const AtomicCalibration& calibration)
+  {
+    if (isReadOnly)
+    {
+      return FuncConvEncode<float>();
+    }
+    return [&calibration](data_t* buffer, float value) {
+      encodeIfWritable(buffer, value, calibration.load(std::memory_order_relaxed));
+    };
+  }
+  static FuncConvDecode<float> decoder(const AtomicCalibration& calibration)
+  {
+    return [&calibration](const data_t* buffer) -> float {
+      return decode(buffer, calibration.load(std::memory_order_relaxed));
+    };
+  }
+
+  /**
+   * Encode only instantiated for writable registers
+   */
+  static inline void encodeIfWritable(data_t* buffer, float value, const Calibration& calibration)
+  {
+    if constexpr (!isReadOnly)
+    {
+      encode(buffer, value, calibration);
+    }
+    else
+    {
+      (void)buffer;
+      (void)value;
+      (void)calibration;
+    }
+  }
+};
+
+/**
+ * DescribedRegister
+ *
+ * Float register whose conversions are resolved
+ * at compile time from given RegisterDescriptor
+ * and calibrated from a shared lock free
+ * calibration snapshot.
+ */
+template <typename Desc>
+class DescribedRegister : public TypedRegisterFloat
+{
+public:
+  /**
+   * Initialization with register name,
+   * the owning Device calibration snapshot and
+   * TypedRegister configuration
+   */
+  DescribedRegister(const std::string& name, const AtomicCalibration& calibration, unsigned int periodPackedRead = 0,
+                    bool forceRead = false, bool forceWrite = false, bool isSlowRegister = false)
+    : TypedRegisterFloat(name, Desc::addr, Desc::length, Desc::encoder(calibration), Desc::decoder(calibration),
+                         periodPackedRead, forceRead, forceWrite, isSlowRegister, Desc::isReadOnly)
+    , _calibration(calibration)
+  {
+  }
+
+protected:
+  /**
+   * Inherit.
+   * Inlined conversions, no std::function
+   * call nor Device mutex on the flush path.
+   */
+  virtual void doConvEncode() override
+  {
+    if constexpr (Desc::isReadOnly)
+    {
+      throw std::logic_error("TypedRegister conv encode on read only Register: " + name);
+    }
+    else
+    {
+      Desc::encode(_dataBufferWrite, _valueWrite, _calibration.load(std::memory_order_relaxed));
+    }
+  }
+  virtual void doConvDecode() override
+  {
+    _valueRead = Desc::decode(_dataBufferRead, _calibration.load(std::memory_order_relaxed));
+    // Call or queue user callback
+    dispatchCallbackRead();
+  }
+
+private:
+  /**
+   * Owning Device calibration snapshot
+   */
+  const AtomicCalibration& _calibration;
+};
+
+}  // namespace RhAL
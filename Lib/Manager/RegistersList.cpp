@@ -55,6 +55,15 @@ void RegistersList::add(TypedRegisterFloat* reg)
   // Register initialization
   initRegister(reg);
 }
+void RegistersList::addBlock(Register* reg)
+{
+  // Check for non intersecting memory
+  checkMemorySpace(reg);
+  // Insert the pointer into the container
+  _registers[reg->name] = reg;
+  // Register initialization
+  initRegister(reg);
+}
 
 const Register& RegistersList::reg(const std::string& name) const
 {
@@ -54,6 +54,16 @@ public:
   void add(TypedRegisterInt* reg);
   void add(TypedRegisterFloat* reg);
 
+  /**
+   * Add a new block Register pointer
+   * (BlockRegister) to the internal container.
+   * It is only available as untyped Register.
+   * No Thread protection.
+   * Throw std::logic_error if register name
+   * is already contained.
+   */
+  void addBlock(Register* reg);
+
   /**
    * Access to given untuyped and Typed register by its name.
    * Throw std::logic_error if asked name does not exists
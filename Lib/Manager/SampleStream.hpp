@@ -0,0 +1,349 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+#include "types.h"
+#include "timestamp.h"
+#include "BlockRegister.hpp"
+
+namespace RhAL
+{
+/**
+ * One timestamped sample
+ * delivered by a SampleStream
+ */
+template <typename T>
+struct StreamSample
+{
+  uint32_t sequence;
+  TimePoint timestamp;
+  T value;
+};
+
+/**
+ * SampleStream
+ *
+ * Support for devices buffering samples on
+ * board in a ring of fixed size slots, each
+ * holding a sample and its sequence number.
+ * The whole ring is read as one block Register
+ * (one bus transaction per read) whose decoding
+ * only copies the ring bytes into the stream
+ * buffer. At each swap following a read,
+ * update() (called from the Device onSwap())
+ * decodes the slots newer than the last delivered
+ * sequence, sorts them, counts lost samples from
+ * sequence gaps and delivers them as one batch to
+ * an optional callback and to a lock free single
+ * consumer queue. Sample timestamps are estimated
+ * back from the read timestamp with the sample
+ * period, so the Manager only has to run faster
+ * than the ring fill time instead of the sensor rate.
+ * Slots with sequence 0 have never been written
+ * by the device and are skipped.
+ * update() is not thread safe (Manager thread),
+ * pop() can be called by one consumer thread.
+ */
+template <typename T>
+class SampleStream
+{
+public:
+  /**
+   * Typedef for slot decode functions
+   */
+  typedef std::function<T(const data_t*)> FuncDecodeSample;
+  typedef std::function<uint32_t(const data_t*)> FuncDecodeSequence;
+
+  /**
+   * Initialization with the ring block
+   * Register name and address, the number
+   * of slots and slot length in bytes, the
+   * slot sample and sequence decode functions
+   * (given the slot data), the sensor sample
+   * period in seconds and the consumer queue
+   * capacity (rounded up to a power of 2).
+   */
+  SampleStream(const std::string& name, addr_t addr, size_t slots, size_t slotLength, FuncDecodeSample decodeSample,
+               FuncDecodeSequence decodeSequence, double samplePeriod, size_t queueCapacity = 1024)
+    : _raw(slots * slotLength)
+    , _register(name, addr, slots * slotLength,
+                [this](const data_t* data) -> unsigned long {
+                  // Only the ring range is copied,
+                  // the block value counts the reads
+                  std::copy(data, data + _raw.size(), _raw.begin());
+                  return ++_countDecoded;
+                },
+                1)
+    , _countDecoded(0)
+    , _countUpdated(0)
+    , _slots(slots)
+    , _slotLength(slotLength)
+    , _decodeSample(decodeSample)
+    , _decodeSequence(decodeSequence)
+    , _samplePeriod(samplePeriod)
+    , _callback([](const StreamSample<T>* samples, size_t count) {
+      (void)samples;
+      (void)count;
+    })
+    , _isStarted(false)
+    , _lastSequence(0)
+    , _countLost(0)
+    , _countDropped(0)
+    , _timestamp()
+    , _isError(true)
+    , _batch()
+    , _order(slots)
+    , _sequences(slots)
+    , _queue()
+    , _mask(0)
+    , _head(0)
+    , _tail(0)
+  {
+    if (slots == 0 || slotLength == 0)
+    {
+      throw std::logic_error("SampleStream invalid ring size: " + name);
+    }
+    size_t capacity = 1;
+    while (capacity < queueCapacity)
+    {
+      capacity *= 2;
+    }
+    _queue.resize(capacity);
+    _mask = capacity - 1;
+    _batch.reserve(slots);
+  }
+
+  /**
+   * Return the ring block Register
+   * to be added to the Device Registers
+   * with RegistersList::addBlock()
+   */
+  Register& reg()
+  {
+    return _register;
+  }
+
+  /**
+   * Set the batch callback called by
+   * update() with new samples in order
+   */
+  void setCallback(std::function<void(const StreamSample<T>*, size_t)> callback)
+  {
+    _callback = callback;
+  }
+
+  /**
+   * Decode the last read ring and
+   * deliver new samples. Return the
+   * number of new samples.
+   * Called by the Device onSwap().
+   */
+  size_t update()
+  {
+    _batch.clear();
+    ReadValue<unsigned long> raw = _register.readValue(true);
+    _timestamp = raw.timestamp;
+    _isError = raw.isError;
+    // Skip read errors and swaps
+    // without newly read ring
+    if (raw.isError || raw.value == _countUpdated)
+    {
+      return 0;
+    }
+    _countUpdated = raw.value;
+    // Select written slots newer than last
+    // delivered sequence (wrap around safe)
+    size_t count = 0;
+    for (size_t k = 0; k < _slots; k++)
+    {
+      uint32_t seq = _decodeSequence(_raw.data() + k * _slotLength);
+      _sequences[k] = seq;
+      if (seq != 0 && (!_isStarted || (int32_t)(seq - _lastSequence) > 0))
+      {
+        // Insertion sort by sequence
+        size_t pos = count;
+        while (pos > 0 && (int32_t)(_sequences[_order[pos - 1]] - seq) > 0)
+        {
+          _order[pos] = _order[pos - 1];
+          pos--;
+        }
+        _order[pos] = k;
+        count++;
+      }
+    }
+    if (count == 0)
+    {
+      return 0;
+    }
+    // Decode, count gaps and estimate
+    // timestamps from the newest sample
+    uint32_t newest = _sequences[_order[count - 1]];
+    for (size_t i = 0; i < count; i++)
+    {
+      uint32_t seq = _sequences[_order[i]];
+      // Skip duplicated sequences
+      // (not yet filled slots)
+      if (_isStarted && (int32_t)(seq - _lastSequence) <= 0)
+      {
+        continue;
+      }
+      if (_isStarted && seq != _lastSequence + 1)
+      {
+        _countLost += seq - _lastSequence - 1;
+      }
+      _isStarted = true;
+      _lastSequence = seq;
+      StreamSample<T> sample;
+      sample.sequence = seq;
+      sample.timestamp = _timestamp - std::chrono::duration_cast<TimePoint::duration>(
+                                          TimeDurationFloat((newest - seq) * _samplePeriod));
+      sample.value = _decodeSample(_raw.data() + _order[i] * _slotLength);
+      _batch.push_back(sample);
+      push(sample);
+    }
+    _callback(_batch.data(), _batch.size());
+    return _batch.size();
+  }
+
+  /**
+   * Return the samples delivered
+   * by the last update()
+   */
+  const std::vector<StreamSample<T>>& batch() const
+  {
+    return _batch;
+  }
+
+  /**
+   * Pop the oldest queued sample into
+   * given reference. Return false if
+   * the queue is empty.
+   * Lock free (single consumer).
+   */
+  bool pop(StreamSample<T>& sample)
+  {
+    size_t tail = _tail.load(std::memory_order_relaxed);
+    if (tail == _head.load(std::memory_order_acquire))
+    {
+      return false;
+    }
+    sample = _queue[tail & _mask];
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Return the last read timestamp
+   * and read error state
+   */
+  TimePoint timestamp() const
+  {
+    return _timestamp;
+  }
+  bool isError() const
+  {
+    return _isError;
+  }
+
+  /**
+   * Return the last delivered sequence,
+   * the number of samples lost on the device
+   * (sequence gaps) and the number of samples
+   * dropped because the queue was full
+   */
+  uint32_t lastSequence() const
+  {
+    return _lastSequence;
+  }
+  unsigned long countLost() const
+  {
+    return _countLost;
+  }
+  unsigned long countDropped() const
+  {
+    return _countDropped;
+  }
+
+private:
+  /**
+   * Last read ring bytes (written by the block
+   * decode during swap, under the Manager lock)
+   */
+  std::vector<data_t> _raw;
+
+  /**
+   * Ring block Register (valued by the
+   * number of decoded reads), number of
+   * decoded reads at last update and layout
+   */
+  BlockRegister<unsigned long> _register;
+  unsigned long _countDecoded;
+  unsigned long _countUpdated;
+  size_t _slots;
+  size_t _slotLength;
+
+  /**
+   * Slot decode functions
+   * and sample period
+   */
+  FuncDecodeSample _decodeSample;
+  FuncDecodeSequence _decodeSequence;
+  double _samplePeriod;
+
+  /**
+   * Batch callback
+   */
+  std::function<void(const StreamSample<T>*, size_t)> _callback;
+
+  /**
+   * Delivery state and counters
+   */
+  bool _isStarted;
+  uint32_t _lastSequence;
+  unsigned long _countLost;
+  std::atomic<unsigned long> _countDropped;
+
+  /**
+   * Last read timestamp and error
+   */
+  TimePoint _timestamp;
+  bool _isError;
+
+  /**
+   * Last batch and ordering buffers
+   */
+  std::vector<StreamSample<T>> _batch;
+  std::vector<size_t> _order;
+  std::vector<uint32_t> _sequences;
+
+  /**
+   * Single producer single consumer
+   * queue, capacity mask and positions
+   */
+  std::vector<StreamSample<T>> _queue;
+  size_t _mask;
+  std::atomic<size_t> _head;
+  std::atomic<size_t> _tail;
+
+  /**
+   * Push given sample in the queue
+   * (dropped if full)
+   */
+  void push(const StreamSample<T>& sample)
+  {
+    size_t head = _head.load(std::memory_order_relaxed);
+    if (head - _tail.load(std::memory_order_acquire) > _mask)
+    {
+      _countDropped++;
+      return;
+    }
+    _queue[head & _mask] = sample;
+    _head.store(head + 1, std::memory_order_release);
+  }
+};
+
+}  // namespace RhAL
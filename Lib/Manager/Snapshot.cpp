@@ -0,0 +1,22 @@
+#include "Manager/Snapshot.hpp"
+#include "Manager/Register.hpp"
+
+namespace RhAL
+{
+const SnapshotEntry& Snapshot::get(id_t id, const std::string& name) const
+{
+  // Entries are sorted by id
+  auto it = std::lower_bound(entries.begin(), entries.end(), id,
+                             [](const SnapshotEntry& entry, id_t val) -> bool { return entry.id < val; });
+  while (it != entries.end() && it->id == id)
+  {
+    if (it->reg->name == name)
+    {
+      return *it;
+    }
+    it++;
+  }
+  throw std::logic_error("Snapshot Register not found: " + std::to_string(id) + " " + name);
+}
+
+}  // namespace RhAL
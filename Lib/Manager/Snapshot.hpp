@@ -0,0 +1,69 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+#include "types.h"
+
+namespace RhAL
+{
+// Forward declaration
+class Register;
+
+/**
+ * SnapshotEntry
+ *
+ * Frozen state of one Register
+ * as of a swap: decoded value (bool, int
+ * and float are stored as double),
+ * hardware read timestamp and last read
+ * error flag.
+ */
+struct SnapshotEntry
+{
+  id_t id;
+  addr_t addr;
+  const Register* reg;
+  double value;
+  TimePoint timestamp;
+  bool isError;
+};
+
+/**
+ * Snapshot
+ *
+ * Immutable whole robot Registers state
+ * published by the Manager at the end
+ * of each swap. Entries are sorted by
+ * Device id and then by Register address.
+ * Entries reg pointers are valid as long
+ * as the Manager is alive.
+ */
+struct Snapshot
+{
+  /**
+   * Swap epoch, incremented
+   * at each publication
+   */
+  unsigned long epoch;
+
+  /**
+   * Publication time
+   */
+  TimePoint timestamp;
+
+  /**
+   * All Registers state
+   */
+  std::vector<SnapshotEntry> entries;
+
+  /**
+   * Return the entry of Register with given
+   * Device id and Register name.
+   * Throw std::logic_error if not found.
+   */
+  const SnapshotEntry& get(id_t id, const std::string& name) const;
+};
+
+}  // namespace RhAL
@@ -44,6 +44,9 @@ void Statistics::reset()
   sumFlushPeriod = TimeDurationMicro(0);
   emergencyCount = 0;
   exitEmergencyCount = 0;
+  maxEmergencyLatency = TimeDurationMicro(0);
+  sumEmergencyLatency = TimeDurationMicro(0);
+  abortedBatchCount = 0;
   deviceOKCount = 0;
   deviceWarningCount = 0;
   deviceQuietCount = 0;
@@ -75,6 +78,12 @@ void Statistics::print(std::ostream& os) const
   os << "ForceWrite() calls: " << forceWriteCount << std::endl;
   os << "EmergencyStop() calls: " << emergencyCount << std::endl;
   os << "ExitEmergencyState() calls: " << exitEmergencyCount << std::endl;
+  if (emergencyCount > 0)
+  {
+    os << "EmergencyStop() mean latency: " << duration_float(sumEmergencyLatency) / emergencyCount << "s" << std::endl;
+  }
+  os << "EmergencyStop() max latency: " << duration_float(maxEmergencyLatency) << "s" << std::endl;
+  os << "Batches aborted by emergency: " << abortedBatchCount << std::endl;
   os << "Read() calls: " << readCount << std::endl;
   os << "Read() bytes length: " << readLength << std::endl;
   os << "Read() sum spent time: " << duration_float(sumReadDuration) << "s" << std::endl;
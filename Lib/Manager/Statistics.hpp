@@ -71,6 +71,14 @@ struct Statistics
   // emergencyStop(), exitEmergencyState()
   unsigned long emergencyCount;
   unsigned long exitEmergencyCount;
+  // Maximum and sum duration between an
+  // emergencyStop() request and the
+  // broadcast being sent on the bus
+  TimeDurationMicro maxEmergencyLatency;
+  TimeDurationMicro sumEmergencyLatency;
+  // Number of batches dropped from
+  // flush() by an emergency stop
+  unsigned long abortedBatchCount;
   // Number of valid (usable) receivned packets
   unsigned long deviceOKCount;
   // Number of read() warnings
@@ -204,6 +204,7 @@ public:
       if (!dev_parameters.isNull())
       {
         _devsById.at(id)->parametersList().loadJSON(dev_parameters);
+        _devsById.at(id)->onParametersUpdate();
       }
     }
   }
@@ -5,6 +5,7 @@
 #include <iostream>
 #include <unistd.h>
 #include <thread>
+#include <algorithm>
 
 #define DEBUG 0
 using namespace std;
@@ -94,10 +95,17 @@ uint8_t* DynamixelV1::Packet::getParameters()
   return buffer + 5;
 }
 
-DynamixelV1::DynamixelV1(Bus& bus) : Protocol(bus), _timeout("timeout", 0.01), _waitAfterWrite("waitAfterWrite", 0.0005)
+DynamixelV1::DynamixelV1(Bus& bus)
+  : Protocol(bus)
+  , _timeout("timeout", 0.01)
+  , _waitAfterWrite("waitAfterWrite", 0.0005)
+  , _turnaroundTime("turnaroundTime", 0.0001)
+  , _abortDrainTime("abortDrainTime", 0.002)
 {
   _parametersList.add(&_timeout);
   _parametersList.add(&_waitAfterWrite);
+  _parametersList.add(&_turnaroundTime);
+  _parametersList.add(&_abortDrainTime);
 }
 
 void DynamixelV1::writeData(id_t id, addr_t address, const uint8_t* data, size_t size)
@@ -107,7 +115,7 @@ void DynamixelV1::writeData(id_t id, addr_t address, const uint8_t* data, size_t
   packet.append(data, size);
   sendPacket(packet);
   // Can't talk to the servos too soon
-  std::this_thread::sleep_for(TimeDurationFloat(_waitAfterWrite.value));
+  waitAfterWrite(packet.getSize());
 }
 
 /**
@@ -279,18 +287,28 @@ void DynamixelV1::syncWrite(const std::vector<id_t>& ids, addr_t address, const
     throw runtime_error("ids and datas should have the same size() for syncWrite");
   }
 
-  size_t N = ids.size();
-  Packet packet(Broadcast, CommandSyncWrite, 2 + N * (size + 1));
-  packet.append(address);
-  packet.append(size);
-  for (size_t k = 0; k < N; k++)
+  // The packet length is one byte. Large
+  // writes are split in as few packets as possible.
+  size_t perPacket = (MaxParameters - 2) / (size + 1);
+  if (perPacket == 0)
   {
-    packet.append(ids[k]);
-    packet.append(datas[k], size);
+    throw runtime_error("syncWrite size too large");
+  }
+  for (size_t start = 0; start < ids.size(); start += perPacket)
+  {
+    size_t N = std::min(perPacket, ids.size() - start);
+    Packet packet(Broadcast, CommandSyncWrite, 2 + N * (size + 1));
+    packet.append(address);
+    packet.append(size);
+    for (size_t k = start; k < start + N; k++)
+    {
+      packet.append(ids[k]);
+      packet.append(datas[k], size);
+    }
+    sendPacket(packet);
+    // Can't talk to the servos too soon
+    waitAfterWrite(packet.getSize());
   }
-  sendPacket(packet);
-  // Can't talk to the servos too soon
-  std::this_thread::sleep_for(TimeDurationFloat(_waitAfterWrite.value));
 }
 
 std::vector<ResponseState> DynamixelV1::syncWriteAndCheck(const std::vector<id_t>& ids, addr_t address,
@@ -309,14 +327,14 @@ void DynamixelV1::emergencyStop()
   uint8_t data1[1];
   data1[0] = 0;
   writeData(Broadcast, 0x18, data1, 1);
-  std::this_thread::sleep_for(TimeDurationFloat(_waitAfterWrite.value));
+  _clock->sleepFor(TimeDurationFloat(_waitAfterWrite.value));
 
   // Set torque limit to zero
   uint8_t data2[2];
   data2[0] = 0x00;
   data2[1] = 0x00;
   writeData(Broadcast, 0x22, data2, 2);
-  std::this_thread::sleep_for(TimeDurationFloat(_waitAfterWrite.value));
+  _clock->sleepFor(TimeDurationFloat(_waitAfterWrite.value));
 }
 
 /**
@@ -328,14 +346,27 @@ void DynamixelV1::exitEmergencyState()
   uint8_t data1[1];
   data1[0] = 1;
   writeData(Broadcast, 0x18, data1, 1);
-  std::this_thread::sleep_for(TimeDurationFloat(_waitAfterWrite.value));
+  _clock->sleepFor(TimeDurationFloat(_waitAfterWrite.value));
 
   // Set torque to maximum
   uint8_t data2[2];
   data2[0] = 0xFF;
   data2[1] = 0x03;
   writeData(Broadcast, 0x22, data2, 2);
-  std::this_thread::sleep_for(TimeDurationFloat(_waitAfterWrite.value));
+  _clock->sleepFor(TimeDurationFloat(_waitAfterWrite.value));
+}
+
+void DynamixelV1::waitAfterWrite(size_t length)
+{
+  if (_isComputedWait && _baudrate > 0)
+  {
+    // 10 bits per byte (start and stop bits)
+    _clock->sleepFor(TimeDurationFloat(10.0 * length / _baudrate + _turnaroundTime.value));
+  }
+  else
+  {
+    _clock->sleepFor(TimeDurationFloat(_waitAfterWrite.value));
+  }
 }
 
 void DynamixelV1::sendPacket(Packet& packet)
@@ -361,9 +392,39 @@ ResponseState DynamixelV1::receivePacket(Packet*& response, id_t id)
   response = NULL;
   TimePoint start = getTimePoint();
   size_t position = 0;
+  bool isDraining = false;
+  TimePoint drainStart;
   while (duration_float(start, getTimePoint()) <= _timeout.value)
   {
+    // If an emergency stop is requested, the expected
+    // status packet may still be in flight and would
+    // collide with the broadcast on the half duplex bus.
+    // It is drained during abortDrainTime and the
+    // transaction is given up only if no packet
+    // is being received.
+    if (position == 0 && isAbortRequested())
+    {
+      if (!isDraining)
+      {
+        isDraining = true;
+        drainStart = getTimePoint();
+      }
+      else if (duration_float(drainStart, getTimePoint()) >= _abortDrainTime.value)
+      {
+        if (response != NULL)
+        {
+          delete response;
+          response = NULL;
+        }
+        return ResponseAborted;
+      }
+    }
     double t = _timeout.value - (duration_float(start, getTimePoint()));
+    // Wait by small slices to poll the abort flag
+    if (_abortFlag != nullptr && t > AbortPollPeriod)
+    {
+      t = AbortPollPeriod;
+    }
     if (bus.waitForData(t))
     {
       size_t n = bus.available();
@@ -28,6 +28,12 @@ class DynamixelV1 : public Protocol
     ErrorInstruction = 64
   };
 
+  /**
+   * Maximum number of parameters
+   * in a packet (one byte length)
+   */
+  static constexpr size_t MaxParameters = 253;
+
   class Packet
   {
   public:
@@ -131,13 +137,34 @@ protected:
                                                     addr_t address, const std::vector<uint8_t*>& datas, size_t size);
 
 private:
+  /**
+   * Maximum duration in seconds of a single
+   * bus wait while the abort flag is polled
+   */
+  static constexpr double AbortPollPeriod = 0.0005;
+
   /**
    * Parameters
    * timeout: wait for receive packet in secondes
    * waitAfterWrite: a delay in seconds to wait
    * after each write
+   * turnaroundTime: devices processing delay in
+   * seconds after a write packet (used by the
+   * computed wait after write)
+   * abortDrainTime: maximum wait in seconds for
+   * a pending status packet on emergency abort
    */
   ParameterNumber _timeout;
   ParameterNumber _waitAfterWrite;
+  ParameterNumber _turnaroundTime;
+  ParameterNumber _abortDrainTime;
+
+  /**
+   * Wait after sending a write packet
+   * of given length in bytes. Either the fixed
+   * waitAfterWrite or, if enabled, the packet
+   * transmission time plus devices turnaround.
+   */
+  void waitAfterWrite(size_t length);
 };
 }  // namespace RhAL
@@ -1,6 +1,5 @@
 #include <iostream>
 #include <random>
-#include <thread>
 #include "FakeProtocol.hpp"
 
 static std::random_device generator;
@@ -24,7 +23,7 @@ void FakeProtocol::writeData(id_t id, addr_t address, const uint8_t* data, size_
     }
     std::cout << std::endl;
   }
-  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  _clock->sleepFor(std::chrono::milliseconds(1));
 }
 
 ResponseState FakeProtocol::readData(id_t id, addr_t address, uint8_t* data, size_t size)
@@ -43,7 +42,7 @@ ResponseState FakeProtocol::readData(id_t id, addr_t address, uint8_t* data, siz
   }
   if (_verbose.value)
     std::cout << std::endl;
-  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  _clock->sleepFor(std::chrono::milliseconds(1));
   return (ResponseOK | ResponseOverload | ResponseOverheat);
 }
 
@@ -66,7 +65,7 @@ bool FakeProtocol::ping(id_t id)
   {
     std::cout << "Ping id=" << id << std::endl;
   }
-  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  _clock->sleepFor(std::chrono::milliseconds(1));
   return false;
 }
 
@@ -101,7 +100,7 @@ std::vector<ResponseState> FakeProtocol::syncRead(const std::vector<id_t>& ids,
   }
   if (_verbose.value)
     std::cout << std::endl;
-  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  _clock->sleepFor(std::chrono::milliseconds(1));
 
   return states;
 }
@@ -128,7 +127,7 @@ void FakeProtocol::syncWrite(const std::vector<id_t>& ids, addr_t address, const
     }
     std::cout << std::endl;
   }
-  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  _clock->sleepFor(std::chrono::milliseconds(1));
 }
 
 std::vector<ResponseState> FakeProtocol::syncWriteAndCheck(const std::vector<id_t>& ids, addr_t address,
@@ -5,7 +5,8 @@ using namespace std;
 
 namespace RhAL
 {
-Protocol::Protocol(Bus& bus) : bus(bus), _parametersList()
+Protocol::Protocol(Bus& bus)
+  : bus(bus), _abortFlag(nullptr), _clock(&defaultClock()), _baudrate(0), _isComputedWait(false), _parametersList()
 {
 }
 
@@ -61,4 +62,32 @@ ParametersList& Protocol::parametersList()
 {
   return _parametersList;
 }
+
+void Protocol::setAbortFlag(const std::atomic<bool>* flag)
+{
+  _abortFlag = flag;
+}
+
+bool Protocol::isAbortRequested() const
+{
+  return _abortFlag != nullptr && _abortFlag->load(std::memory_order_relaxed);
+}
+
+void Protocol::setClock(Clock* clock)
+{
+  if (clock == nullptr)
+  {
+    _clock = &defaultClock();
+  }
+  else
+  {
+    _clock = clock;
+  }
+}
+
+void Protocol::setLinkTiming(unsigned long baudrate, bool isComputedWait)
+{
+  _baudrate = baudrate;
+  _isComputedWait = isComputedWait;
+}
 }  // namespace RhAL
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <vector>
+#include <atomic>
 #include <stdint.h>
 #include "types.h"
 #include "timestamp.h"
+#include "Clock.hpp"
 #include "Bus/Bus.hpp"
 #include "Manager/ParametersList.hpp"
 
@@ -30,7 +32,11 @@ enum : ResponseState
   ResponseDeviceBadChecksum = 256,
   ResponseBadSize = 512,
   ResponseBadProtocol = 1024,
-  ResponseBadId = 2048
+  ResponseBadId = 2048,
+
+  // The transaction was given up because
+  // an emergency stop was requested
+  ResponseAborted = 4096
 };
 
 class Protocol
@@ -111,12 +117,59 @@ public:
   const ParametersList& parametersList() const;
   ParametersList& parametersList();
 
+  /**
+   * Set the flag polled while waiting for
+   * a response. When it is raised, the pending
+   * transaction is given up at the next packet
+   * boundary and ResponseAborted is returned.
+   * The flag is not owned (can be null).
+   */
+  void setAbortFlag(const std::atomic<bool>* flag);
+
+  /**
+   * Return true if the abort flag is raised
+   */
+  bool isAbortRequested() const;
+
+  /**
+   * Set the clock used for the waits
+   * between packets (not owned).
+   * Null resets to the default clock.
+   */
+  void setClock(Clock* clock);
+
+  /**
+   * Set the bus baudrate in BPS and enable
+   * or disable the computed wait after write
+   * packets (derived from packet length, baudrate
+   * and device turnaround) instead of the
+   * fixed protocol wait.
+   */
+  void setLinkTiming(unsigned long baudrate, bool isComputedWait);
+
 protected:
   /**
    * Bus used for communication
    */
   Bus& bus;
 
+  /**
+   * Optional abort request flag
+   */
+  const std::atomic<bool>* _abortFlag;
+
+  /**
+   * Time source for waits
+   */
+  Clock* _clock;
+
+  /**
+   * Bus baudrate and computed
+   * wait after write state
+   */
+  unsigned long _baudrate;
+  bool _isComputedWait;
+
   /**
    * Protocol parameters
    */
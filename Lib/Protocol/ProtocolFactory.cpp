@@ -1,6 +1,7 @@
 #include "ProtocolFactory.hpp"
 #include "Protocol/DynamixelV1.hpp"
 #include "Protocol/FakeProtocol.hpp"
+#include "Protocol/ReplayProtocol.hpp"
 
 namespace RhAL
 {
@@ -14,6 +15,10 @@ Protocol* ProtocolFactory(const std::string& name, Bus& bus)
   {
     return new FakeProtocol(bus);
   }
+  else if (name == "ReplayProtocol")
+  {
+    return new ReplayProtocol(bus);
+  }
   else
   {
     return nullptr;
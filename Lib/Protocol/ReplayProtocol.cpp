@@ -0,0 +1,274 @@
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include "ReplayProtocol.hpp"
+#include "timestamp.h"
+
+namespace RhAL
+{
+/**
+ * Maximum number of recorded transactions
+ * skipped to resynchronize on a mismatching
+ * request (not strict mode)
+ */
+static constexpr size_t ReplayResyncWindow = 256;
+
+ReplayProtocol::ReplayProtocol(Bus& bus)
+  : Protocol(bus)
+  , _paramPath("path", "")
+  , _paramRealTime("realTime", false)
+  , _paramLoop("loop", false)
+  , _paramStrict("strict", true)
+  , _loadedPath()
+  , _transactions()
+  , _cursor(0)
+  , _playbackStart()
+  , _recordStart(0)
+  , _isStarted(false)
+  , _mismatchCount(0)
+{
+  _parametersList.add(&_paramPath);
+  _parametersList.add(&_paramRealTime);
+  _parametersList.add(&_paramLoop);
+  _parametersList.add(&_paramStrict);
+}
+
+void ReplayProtocol::writeData(id_t id, addr_t address, const uint8_t* data, size_t size)
+{
+  const FlightTransaction* transaction = next(FlightRecordWrite, id, address, size, data);
+  if (transaction != nullptr)
+  {
+    waitRecordTime(*transaction);
+  }
+}
+
+ResponseState ReplayProtocol::writeAndCheckData(id_t id, addr_t address, const uint8_t* data, size_t size)
+{
+  const FlightTransaction* transaction = next(FlightRecordWrite, id, address, size, data);
+  if (transaction == nullptr)
+  {
+    return ResponseQuiet;
+  }
+  waitRecordTime(*transaction);
+  // Unchecked recorded write
+  if (transaction->state == 0)
+  {
+    return ResponseOK;
+  }
+  return transaction->state;
+}
+
+ResponseState ReplayProtocol::readData(id_t id, addr_t address, uint8_t* data, size_t size)
+{
+  const FlightTransaction* transaction = next(0, id, address, size, nullptr);
+  if (transaction == nullptr)
+  {
+    return ResponseQuiet;
+  }
+  waitRecordTime(*transaction);
+  std::memcpy(data, transaction->data.data(), size);
+  return transaction->state;
+}
+
+bool ReplayProtocol::ping(id_t id)
+{
+  // Only pings recorded as
+  // answered are acknowledged
+  const FlightTransaction* transaction = next(FlightRecordPing, id, 0, 0, nullptr);
+  if (transaction == nullptr)
+  {
+    return false;
+  }
+  waitRecordTime(*transaction);
+  return transaction->state == ResponseOK;
+}
+
+std::vector<ResponseState> ReplayProtocol::syncRead(const std::vector<id_t>& ids, addr_t address,
+                                                    const std::vector<uint8_t*>& datas, size_t size)
+{
+  std::vector<ResponseState> states;
+  for (size_t i = 0; i < ids.size(); i++)
+  {
+    const FlightTransaction* transaction = next(FlightRecordSync, ids[i], address, size, nullptr);
+    if (transaction == nullptr)
+    {
+      states.push_back(ResponseQuiet);
+      continue;
+    }
+    // The sync read ends with
+    // the last Device answer
+    if (i + 1 == ids.size())
+    {
+      waitRecordTime(*transaction);
+    }
+    std::memcpy(datas[i], transaction->data.data(), size);
+    states.push_back(transaction->state);
+  }
+
+  return states;
+}
+
+void ReplayProtocol::syncWrite(const std::vector<id_t>& ids, addr_t address, const std::vector<const uint8_t*>& datas,
+                               size_t size)
+{
+  syncWriteAndCheck(ids, address, datas, size);
+}
+
+std::vector<ResponseState> ReplayProtocol::syncWriteAndCheck(const std::vector<id_t>& ids, addr_t address,
+                                                             const std::vector<const uint8_t*>& datas, size_t size)
+{
+  std::vector<ResponseState> states;
+  const FlightTransaction* last = nullptr;
+  for (size_t i = 0; i < ids.size(); i++)
+  {
+    const FlightTransaction* transaction =
+        next(FlightRecordWrite | FlightRecordSync, ids[i], address, size, datas[i]);
+    if (transaction == nullptr)
+    {
+      states.push_back(ResponseQuiet);
+    }
+    else
+    {
+      states.push_back(transaction->state == 0 ? (ResponseState)ResponseOK : transaction->state);
+      last = transaction;
+    }
+  }
+  if (last != nullptr)
+  {
+    waitRecordTime(*last);
+  }
+
+  return states;
+}
+
+void ReplayProtocol::emergencyStop()
+{
+  // Not recorded
+}
+void ReplayProtocol::exitEmergencyState()
+{
+  // Not recorded
+}
+
+void ReplayProtocol::rewind()
+{
+  checkLoaded();
+  _cursor = 0;
+  _isStarted = false;
+  _mismatchCount = 0;
+}
+
+bool ReplayProtocol::isFinished()
+{
+  checkLoaded();
+  return _cursor >= _transactions.size();
+}
+
+unsigned long ReplayProtocol::countMismatches() const
+{
+  return _mismatchCount;
+}
+
+void ReplayProtocol::checkLoaded()
+{
+  if (_paramPath.value == "")
+  {
+    throw std::runtime_error("ReplayProtocol no session path configured");
+  }
+  if (_paramPath.value == _loadedPath)
+  {
+    return;
+  }
+  FlightRecorderHeader header;
+  _transactions = FlightRecorder::merge(FlightRecorder::load(_paramPath.value, header));
+  _loadedPath = _paramPath.value;
+  _cursor = 0;
+  _isStarted = false;
+  _mismatchCount = 0;
+}
+
+const FlightTransaction* ReplayProtocol::next(uint8_t type, id_t id, addr_t address, size_t size, const uint8_t* data)
+{
+  checkLoaded();
+  if (_cursor >= _transactions.size())
+  {
+    if (!_paramLoop.value || _transactions.empty())
+    {
+      // Request beyond the recorded session
+      _mismatchCount++;
+      if (_paramStrict.value)
+      {
+        throw std::runtime_error("ReplayProtocol request after the end of the session: id=" + std::to_string(id) +
+                                 " addr=" + std::to_string(address));
+      }
+      return nullptr;
+    }
+    // Restart the session
+    _cursor = 0;
+    _isStarted = false;
+  }
+  // Forced flag is not seen by the Protocol
+  uint8_t mask = FlightRecordWrite | FlightRecordSync | FlightRecordPing;
+  auto isMatching = [type, id, address, size, mask](const FlightTransaction& transaction) -> bool {
+    return (transaction.type & mask) == type && transaction.id == id && transaction.addr == address &&
+           transaction.data.size() == size;
+  };
+  // Look for the request in next
+  // recorded transactions
+  size_t index = _cursor;
+  size_t end = std::min(_transactions.size(), _cursor + (_paramStrict.value ? 1 : ReplayResyncWindow));
+  while (index < end && !isMatching(_transactions[index]))
+  {
+    index++;
+  }
+  if (index != _cursor)
+  {
+    _mismatchCount++;
+    if (_paramStrict.value)
+    {
+      const FlightTransaction& expected = _transactions[_cursor];
+      throw std::runtime_error("ReplayProtocol request mismatch: got type=" + std::to_string(type) +
+                               " id=" + std::to_string(id) + " addr=" + std::to_string(address) +
+                               " size=" + std::to_string(size) + ", expected type=" +
+                               std::to_string(expected.type & mask) + " id=" + std::to_string(expected.id) +
+                               " addr=" + std::to_string(expected.addr) +
+                               " size=" + std::to_string(expected.data.size()));
+    }
+    if (index == end)
+    {
+      // Not found, the request is
+      // ignored and the cursor kept
+      return nullptr;
+    }
+  }
+  const FlightTransaction* transaction = &_transactions[index];
+  _cursor = index + 1;
+  // Check written bytes
+  if (data != nullptr && std::memcmp(data, transaction->data.data(), size) != 0)
+  {
+    _mismatchCount++;
+    if (_paramStrict.value)
+    {
+      throw std::runtime_error("ReplayProtocol written data mismatch: id=" + std::to_string(id) +
+                               " addr=" + std::to_string(address));
+    }
+  }
+
+  return transaction;
+}
+
+void ReplayProtocol::waitRecordTime(const FlightTransaction& transaction)
+{
+  if (!_isStarted)
+  {
+    _playbackStart = _clock->now();
+    _recordStart = transaction.time;
+    _isStarted = true;
+  }
+  if (_paramRealTime.value && transaction.time > _recordStart)
+  {
+    _clock->sleepUntil(_playbackStart + std::chrono::nanoseconds(transaction.time - _recordStart));
+  }
+}
+
+}  // namespace RhAL
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "Protocol.hpp"
+#include "Manager/Parameter.hpp"
+#include "Manager/FlightRecorder.hpp"
+
+namespace RhAL
+{
+/**
+ * ReplayProtocol
+ *
+ * Deterministic playback of a bus session
+ * recorded by the Manager flight recorder.
+ * Each request is checked against the next
+ * recorded transaction (same kind, ids, address,
+ * length and written bytes) and is answered
+ * with the recorded read bytes and response states.
+ * Pings (scan, Devices check) are replayed as
+ * recorded too and only acknowledged if they
+ * were answered.
+ * The bus is never used.
+ */
+class ReplayProtocol : public Protocol
+{
+public:
+  ReplayProtocol(Bus& bus);
+
+  /**
+   * Inherit from Protocol
+   */
+  void writeData(id_t id, addr_t address, const uint8_t* data, size_t size);
+  ResponseState writeAndCheckData(id_t id, addr_t address, const uint8_t* data, size_t size);
+  ResponseState readData(id_t id, addr_t address, uint8_t* data, size_t size);
+  bool ping(id_t id);
+  std::vector<ResponseState> syncRead(const std::vector<id_t>& ids, addr_t address, const std::vector<uint8_t*>& datas,
+                                      size_t size);
+  void syncWrite(const std::vector<id_t>& ids, addr_t address, const std::vector<const uint8_t*>& datas, size_t size);
+  std::vector<ResponseState> syncWriteAndCheck(const std::vector<id_t>& ids, addr_t address,
+                                               const std::vector<const uint8_t*>& datas, size_t size);
+  virtual void emergencyStop() override;
+  virtual void exitEmergencyState() override;
+
+  /**
+   * Restart the playback from the
+   * beginning of the session (the log
+   * is reloaded if path has changed)
+   */
+  void rewind();
+
+  /**
+   * Return true if all recorded
+   * transactions have been replayed
+   */
+  bool isFinished();
+
+  /**
+   * Return the number of requests not
+   * matching the recorded session
+   * since last rewind
+   */
+  unsigned long countMismatches() const;
+
+private:
+  /**
+   * Parameters
+   * path: flight recorder log to replay.
+   * realTime: if true, each answer is delayed until
+   * its recorded time relative to the first replayed
+   * transaction, else the session is replayed as fast
+   * as possible.
+   * loop: restart from the beginning when the end
+   * of the session is reached.
+   * strict: throw std::runtime_error on mismatching
+   * request (or request after the end of the session),
+   * else count it and resynchronize.
+   */
+  ParameterStr _paramPath;
+  ParameterBool _paramRealTime;
+  ParameterBool _paramLoop;
+  ParameterBool _paramStrict;
+
+  /**
+   * Loaded log path and
+   * recorded transactions
+   */
+  std::string _loadedPath;
+  std::vector<FlightTransaction> _transactions;
+
+  /**
+   * Next transaction to replay
+   */
+  size_t _cursor;
+
+  /**
+   * Playback start time and record
+   * time of its first transaction
+   */
+  TimePoint _playbackStart;
+  uint64_t _recordStart;
+  bool _isStarted;
+
+  /**
+   * Mismatching requests count
+   */
+  unsigned long _mismatchCount;
+
+  /**
+   * Load the log if the path parameter
+   * has changed. Throw std::runtime_error
+   * if no log is configured.
+   */
+  void checkLoaded();
+
+  /**
+   * Return the next recorded transaction
+   * matching given type flags, id, address and
+   * length and advance the cursor (nullptr if
+   * not found). Mismatches are counted or thrown.
+   * If data is not null, written bytes are
+   * compared too.
+   */
+  const FlightTransaction* next(uint8_t type, id_t id, addr_t address, size_t size, const uint8_t* data);
+
+  /**
+   * Wait the recorded time of given
+   * transaction in real time mode
+   */
+  void waitRecordTime(const FlightTransaction& transaction);
+};
+
+}  // namespace RhAL
@@ -7,6 +7,7 @@
 #include "Manager/Statistics.hpp"
 #include "Manager/CallManager.hpp"
 #include "Manager/Register.hpp"
+#include "Manager/BlockRegister.hpp"
 #include "Manager/Parameter.hpp"
 #include "Manager/RegistersList.hpp"
 #include "Manager/ParametersList.hpp"
@@ -15,7 +16,10 @@
 #include "Manager/BaseManager.hpp"
 #include "Manager/AggregateManager.hpp"
 #include "Manager/Manager.hpp"
+#include "Manager/Bench.hpp"
 #include "Bindings/RhIOBinding.hpp"
+#include "Bindings/SharedMemoryServer.hpp"
+#include "Bindings/SharedMemoryClient.hpp"
 
 #include "Devices/ExampleDevice1.hpp"
 #include "Devices/ExampleDevice2.hpp"
@@ -23,6 +27,8 @@
 #include "Devices/MX106.hpp"
 #include "Devices/MX64.hpp"
 #include "Devices/Dynaban64.hpp"
+#include "Devices/DynabanTrajectoryGroup.hpp"
+#include "Devices/DynabanTrajectoryFeeder.hpp"
 #include "Devices/MX28.hpp"
 #include "Devices/MX12.hpp"
 #include "Devices/RX64.hpp"
@@ -0,0 +1,122 @@
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include <utility>
+#include "RhAL.hpp"
+#include "tests.h"
+
+using namespace RhAL;
+
+/**
+ * Device baudrate Register codes
+ */
+static void testCodes()
+{
+  MX28 mx("mx", 1);
+  RX28 rx("rx", 2);
+  addr_t addr = 0;
+  data_t code = 0;
+
+  assertEquals(mx.baudrateCode(1000000, addr, code), true);
+  assertEquals(addr, (addr_t)0x04);
+  assertEquals(code, (data_t)1);
+  assertEquals(mx.baudrateCode(57142, addr, code), false);
+  assertEquals(mx.baudrateCode(200000, addr, code), true);
+  assertEquals(code, (data_t)9);
+  assertEquals(mx.baudrateCode(2000000, addr, code), true);
+  assertEquals(code, (data_t)0);
+  assertEquals(mx.baudrateCode(2250000, addr, code), true);
+  assertEquals(code, (data_t)250);
+  assertEquals(mx.baudrateCode(3000000, addr, code), true);
+  assertEquals(code, (data_t)252);
+  assertEquals(mx.baudrateCode(4500000, addr, code), false);
+
+  assertEquals(rx.baudrateCode(1000000, addr, code), true);
+  assertEquals(code, (data_t)1);
+  assertEquals(rx.baudrateCode(2000000, addr, code), false);
+  assertEquals(rx.baudrateCode(0, addr, code), false);
+}
+
+/**
+ * Negotiation with FakeProtocol which reads
+ * back all bytes as zero: only the 2Mbps
+ * code (zero) of MX Devices is read back
+ * without error
+ */
+static void testNegotiation()
+{
+  const unsigned int burst = 10;
+  StandardManager manager;
+  manager.setProtocolConfig("", 2000000, "FakeProtocol");
+
+  // Nothing to negotiate without present Device
+  assertEquals(manager.negotiateBaudrate(), (unsigned long)2000000);
+
+  // Devices are marked present
+  // by read responses
+  manager.devAdd<MX28>(1, "left");
+  manager.devAdd<MX28>(2, "right");
+  manager.flush();
+  assertEquals(manager.devById(1).isPresent(), true);
+  assertEquals(manager.devById(2).isPresent(), true);
+
+  // Already known baudrate and unsupported
+  // ones are skipped, the first failing one
+  // switches back and ends the negotiation
+  // The Protocol (and its Parameters) is kept
+  manager.resetStatistics();
+  const ParametersList* protocolParameters = &manager.protocolParametersList();
+  std::vector<std::pair<unsigned long, unsigned long>> report;
+  unsigned long selected = manager.negotiateBaudrate({ 1000000, 4500000, 2250000, 3000000 }, burst, &report);
+  assertEquals(selected, (unsigned long)2000000);
+  assertEquals(&manager.protocolParametersList() == protocolParameters, true);
+  assertEquals(report.size(), (size_t)3);
+  assertEquals(report[0].first, (unsigned long)2000000);
+  assertEquals(report[0].second, (unsigned long)0);
+  assertEquals(report[1].first, (unsigned long)2250000);
+  assertEquals(report[1].second, (unsigned long)(2 * burst));
+  assertEquals(report[2].first, (unsigned long)2000000);
+  assertEquals(report[2].second, (unsigned long)0);
+  assertEquals(manager.BaseManager::parametersList().paramNumber("baudrate").value, 2000000.0);
+  Statistics stats = manager.getStatistics();
+  assertEquals(stats.syncWriteCount, (unsigned long)(1 + 3));
+  assertEquals(stats.syncReadCount, (unsigned long)(3 * burst));
+
+  // Failing current baudrate is kept
+  // without switching the Devices
+  manager.setProtocolConfig("", 1000000, "FakeProtocol");
+  manager.resetStatistics();
+  report.clear();
+  selected = manager.negotiateBaudrate({ 2000000, 3000000 }, burst, &report);
+  assertEquals(selected, (unsigned long)1000000);
+  assertEquals(report.size(), (size_t)1);
+  assertEquals(report[0].second, (unsigned long)(2 * burst));
+  stats = manager.getStatistics();
+  assertEquals(stats.syncWriteCount, (unsigned long)0);
+  assertEquals(stats.syncReadCount, (unsigned long)burst);
+
+  // All present Devices have to
+  // support the negotiation
+  manager.devAdd<IMU>(3, "imu");
+  manager.flush();
+  assertEquals(manager.devById(3).isPresent(), true);
+  bool isThrown = false;
+  try
+  {
+    manager.negotiateBaudrate();
+  }
+  catch (const std::logic_error&)
+  {
+    isThrown = true;
+  }
+  assertEquals(isThrown, true);
+}
+
+int main()
+{
+  testCodes();
+  testNegotiation();
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
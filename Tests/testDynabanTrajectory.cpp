@@ -0,0 +1,219 @@
+#include <iostream>
+#include <functional>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <unistd.h>
+#include "RhAL.hpp"
+#include "tests.h"
+
+using namespace RhAL;
+
+/**
+ * Dynaban64 trajectory buffers
+ * and control registers addresses
+ */
+constexpr addr_t AddrBuffer1 = 0x4A;
+constexpr addr_t AddrBuffer2 = 0x76;
+constexpr addr_t AddrBufferEnd = 0xA2;
+constexpr addr_t AddrMode = 0xA2;
+constexpr addr_t AddrCopyNextBuffer = 0xA3;
+
+/**
+ * Create an empty temporary
+ * file and return its path
+ */
+static std::string tempPath()
+{
+  char path[] = "/tmp/rhalTestXXXXXX";
+  int fd = mkstemp(path);
+  if (fd < 0)
+  {
+    throw std::runtime_error("Unable to create temporary file");
+  }
+  close(fd);
+  return path;
+}
+
+/**
+ * Run given function while the Manager
+ * flight recorder is enabled and return
+ * the recorded write transactions
+ */
+static std::vector<FlightTransaction> recordWrites(StandardManager& manager, std::function<void()> func)
+{
+  std::string path = tempPath();
+  manager.setFlightRecorder(path, 4096);
+  func();
+  manager.setFlightRecorder("", 1);
+  FlightRecorderHeader header;
+  std::vector<FlightTransaction> transactions = FlightRecorder::merge(FlightRecorder::load(path, header));
+  std::remove(path.c_str());
+  std::vector<FlightTransaction> writes;
+  for (const FlightTransaction& transaction : transactions)
+  {
+    if (transaction.type & FlightRecordWrite)
+    {
+      writes.push_back(transaction);
+    }
+  }
+  return writes;
+}
+
+/**
+ * Return true if given transaction
+ * writes any byte in [begin, end[
+ */
+static bool isWriting(const FlightTransaction& transaction, addr_t begin, addr_t end)
+{
+  return transaction.addr < end && transaction.addr + (addr_t)transaction.data.size() > begin;
+}
+
+/**
+ * Check that given writes only touch the given
+ * buffer range and copyNextBuffer, never the mode,
+ * and cover the range for all Devices
+ */
+static void checkUpload(const std::vector<FlightTransaction>& writes, addr_t begin, size_t count)
+{
+  std::vector<size_t> bytes(count + 1, 0);
+  for (const FlightTransaction& transaction : writes)
+  {
+    assertEquals(isWriting(transaction, AddrMode, AddrMode + 1), false);
+    if (transaction.addr == AddrCopyNextBuffer)
+    {
+      assertEquals(transaction.data.size(), (size_t)1);
+      continue;
+    }
+    assertEquals(transaction.addr >= begin, true);
+    assertEquals(transaction.addr + transaction.data.size() <= AddrBufferEnd, true);
+    bytes.at(transaction.id) += transaction.data.size();
+  }
+  for (size_t id = 1; id <= count; id++)
+  {
+    assertEquals(bytes[id], (size_t)(AddrBufferEnd - begin));
+  }
+}
+
+/**
+ * Group upload and start sequence
+ */
+static void testGroup()
+{
+  const size_t count = 3;
+  StandardManager manager;
+  manager.setScheduleMode(true);
+  std::vector<std::string> names;
+  for (size_t i = 1; i <= count; i++)
+  {
+    names.push_back("dev" + std::to_string(i));
+    manager.devAdd<Dynaban64>(i, names.back());
+  }
+  manager.flush();
+
+  DynabanTrajectoryGroup group(manager, names);
+  DynabanTrajectory traj = { { 1.0, 2.0, 3.0, 0.0, 0.0 }, 3, { 0.1, 0.0, 0.0, 0.0, 0.0 }, 1, 0.5 };
+
+  // First trajectory: both buffers
+  std::vector<FlightTransaction> writes = recordWrites(manager, [&]() {
+    for (size_t i = 0; i < group.size(); i++)
+    {
+      group.setFirstTrajectory(i, traj);
+    }
+    group.upload();
+    manager.flush();
+  });
+  checkUpload(writes, AddrBuffer1, count);
+
+  // Start: only the mode
+  writes = recordWrites(manager, [&]() {
+    group.startAll(3);
+    manager.flush();
+  });
+  assertEquals(writes.size() > 0, true);
+  for (const FlightTransaction& transaction : writes)
+  {
+    assertEquals(transaction.addr, AddrMode);
+    assertEquals(transaction.data.size(), (size_t)1);
+  }
+
+  // Next trajectory: only the buffer 2
+  writes = recordWrites(manager, [&]() {
+    for (size_t i = 0; i < group.size(); i++)
+    {
+      group.setNextTrajectory(i, traj);
+    }
+    group.upload();
+    manager.flush();
+  });
+  checkUpload(writes, AddrBuffer2, count);
+}
+
+/**
+ * Feeder start is delayed until
+ * the upload has been flushed
+ */
+static void testFeederStart()
+{
+  const size_t count = 2;
+  StandardManager manager;
+  manager.setScheduleMode(true);
+  std::vector<std::string> names;
+  for (size_t i = 1; i <= count; i++)
+  {
+    names.push_back("dev" + std::to_string(i));
+    manager.devAdd<Dynaban64>(i, names.back());
+  }
+  manager.flush();
+
+  DynabanTrajectoryFeeder feeder(manager, names);
+  unsigned long startCycle = manager.cycleCount();
+  std::vector<FlightTransaction> writes = recordWrites(manager, [&]() {
+    for (size_t i = 0; i < count; i++)
+    {
+      feeder.pushWaypoint(i, 10.0, 0.0, 0.5);
+      feeder.pushWaypoint(i, 20.0, 0.0, 0.5);
+    }
+    feeder.start(3);
+    for (int k = 0; k < 4; k++)
+    {
+      feeder.update();
+      // Mode is written once, at the
+      // second flush following the upload
+      assertEquals(feeder.group().dev(0).mode().needWrite(), manager.cycleCount() == startCycle + 2);
+      manager.flush();
+    }
+  });
+
+  // All uploads are flushed
+  // strictly before the mode
+  bool isMode = false;
+  unsigned long modeCycle = 0;
+  unsigned long uploadCycle = 0;
+  for (const FlightTransaction& transaction : writes)
+  {
+    if (isWriting(transaction, AddrMode, AddrMode + 1))
+    {
+      isMode = true;
+      modeCycle = transaction.cycle;
+    }
+    else
+    {
+      uploadCycle = std::max(uploadCycle, (unsigned long)transaction.cycle);
+    }
+  }
+  assertEquals(isMode, true);
+  assertEquals(uploadCycle < modeCycle, true);
+  assertEquals(feeder.isRunning(), true);
+}
+
+int main()
+{
+  testGroup();
+  testFeederStart();
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
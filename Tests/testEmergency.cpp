@@ -0,0 +1,220 @@
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include "RhAL.hpp"
+#include "Bus/Bus.hpp"
+#include "Protocol/DynamixelV1.hpp"
+#include "tests.h"
+
+using namespace RhAL;
+
+/**
+ * Simulated half duplex bus answering
+ * each sent packet with a fixed status
+ * packet after a given delay
+ */
+class DelayedBus : public Bus
+{
+public:
+  DelayedBus(const std::vector<uint8_t>& reply, double delay)
+    : _reply(reply), _delay(delay), _isInFlight(false), _input()
+  {
+  }
+
+  bool sendData(uint8_t* data, size_t size) override
+  {
+    (void)data;
+    (void)size;
+    if (!_reply.empty())
+    {
+      _isInFlight = true;
+      _replyTime = getTimePoint();
+    }
+    return true;
+  }
+  bool waitForData(double timeout) override
+  {
+    deliver();
+    if (_input.empty() && timeout > 0.0)
+    {
+      double wait = timeout;
+      if (_isInFlight)
+      {
+        double left = _delay - duration_float(_replyTime, getTimePoint());
+        wait = std::max(0.0, std::min(wait, left));
+      }
+      std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+      deliver();
+    }
+    return !_input.empty();
+  }
+  size_t readData(uint8_t* data, size_t size) override
+  {
+    size_t n = std::min(size, _input.size());
+    std::copy(_input.begin(), _input.begin() + n, data);
+    _input.erase(_input.begin(), _input.begin() + n);
+    return n;
+  }
+  void flush() override
+  {
+  }
+  void clearInputBuffer() override
+  {
+    // Bytes still on the wire are not cleared
+    deliver();
+    _input.clear();
+  }
+  size_t available() override
+  {
+    deliver();
+    return _input.size();
+  }
+
+  /**
+   * Return true if received bytes are
+   * left on the bus (collision with
+   * the next sent packet)
+   */
+  bool isPending()
+  {
+    deliver();
+    return _isInFlight || !_input.empty();
+  }
+
+private:
+  std::vector<uint8_t> _reply;
+  double _delay;
+  bool _isInFlight;
+  TimePoint _replyTime;
+  std::vector<uint8_t> _input;
+
+  void deliver()
+  {
+    if (_isInFlight && duration_float(_replyTime, getTimePoint()) >= _delay)
+    {
+      _input.insert(_input.end(), _reply.begin(), _reply.end());
+      _isInFlight = false;
+    }
+  }
+};
+
+/**
+ * Build a DynamixelV1 status packet
+ */
+static std::vector<uint8_t> statusPacket(uint8_t id, const std::vector<uint8_t>& params)
+{
+  uint8_t length = params.size() + 2;
+  std::vector<uint8_t> packet = { 0xff, 0xff, id, length, 0x00 };
+  uint8_t sum = id + length;
+  for (uint8_t b : params)
+  {
+    packet.push_back(b);
+    sum += b;
+  }
+  packet.push_back(~sum);
+  return packet;
+}
+
+/**
+ * Protocol level abort of a pending
+ * read transaction
+ */
+static void testProtocolAbort()
+{
+  std::atomic<bool> abort(true);
+  uint8_t data[2] = { 0, 0 };
+
+  // No device answers: the transaction is given
+  // up after abortDrainTime, before the timeout
+  DelayedBus busQuiet({}, 0.0);
+  DynamixelV1 protocolQuiet(busQuiet);
+  protocolQuiet.setAbortFlag(&abort);
+  TimePoint start = getTimePoint();
+  ResponseState state = protocolQuiet.readData(1, 0x24, data, 2);
+  double duration = duration_float(start, getTimePoint());
+  assertEquals(state, (ResponseState)ResponseAborted);
+  assertEquals(duration < 0.008, true);
+
+  // The status packet arrives during the drain
+  // time: it is consumed and no byte is left
+  // to collide with the emergency broadcast
+  DelayedBus busReply(statusPacket(1, { 0x34, 0x12 }), 0.001);
+  DynamixelV1 protocolReply(busReply);
+  protocolReply.setAbortFlag(&abort);
+  state = protocolReply.readData(1, 0x24, data, 2);
+  assertEquals((bool)(state & ResponseOK), true);
+  assertEquals(data[0], (uint8_t)0x34);
+  assertEquals(data[1], (uint8_t)0x12);
+  assertEquals(busReply.isPending(), false);
+
+  // Without abort request, the usual
+  // timeout applies
+  abort = false;
+  start = getTimePoint();
+  state = protocolQuiet.readData(1, 0x24, data, 2);
+  duration = duration_float(start, getTimePoint());
+  assertEquals(state, (ResponseState)ResponseQuiet);
+  assertEquals(duration >= 0.01, true);
+}
+
+/**
+ * Manager level abort of a running flush
+ */
+static void testManagerAbort()
+{
+  const size_t count = 20;
+  StandardManager manager;
+  manager.setEnableSyncWrite(false);
+  for (size_t i = 1; i <= count; i++)
+  {
+    manager.devAdd<MX28>(i, "dev" + std::to_string(i));
+  }
+  manager.flush();
+  manager.resetStatistics();
+
+  // One write batch (1ms each with
+  // FakeProtocol) for each Device
+  for (size_t i = 1; i <= count; i++)
+  {
+    manager.dev<MX28>(i).goalPosition().writeValue(10.0);
+  }
+  std::thread flushThread([&manager]() { manager.flush(); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  manager.emergencyStop();
+  flushThread.join();
+
+  Statistics stats = manager.getStatistics();
+  assertEquals(stats.emergencyCount, (unsigned long)1);
+  assertEquals(stats.abortedBatchCount > 0, true);
+  assertEquals(stats.writeErrorCount > 0, true);
+
+  // Not performed writes are
+  // kept for the next flush
+  unsigned long pending = 0;
+  for (size_t i = 1; i <= count; i++)
+  {
+    if (manager.dev<MX28>(i).goalPosition().needWrite())
+    {
+      pending++;
+    }
+  }
+  assertEquals(pending, stats.writeErrorCount);
+  assertEquals(pending < count, true);
+
+  manager.flush();
+  for (size_t i = 1; i <= count; i++)
+  {
+    assertEquals(manager.dev<MX28>(i).goalPosition().needWrite(), false);
+  }
+}
+
+int main()
+{
+  testProtocolAbort();
+  testManagerAbort();
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,188 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <stdexcept>
+#include <unistd.h>
+#include "RhAL.hpp"
+#include "Bus/Bus.hpp"
+#include "Protocol/ReplayProtocol.hpp"
+#include "tests.h"
+
+using namespace RhAL;
+
+/**
+ * Create an empty temporary
+ * file and return its path
+ */
+static std::string tempPath()
+{
+  char path[] = "/tmp/rhalTestXXXXXX";
+  int fd = mkstemp(path);
+  if (fd < 0)
+  {
+    throw std::runtime_error("Unable to create temporary file");
+  }
+  close(fd);
+  return path;
+}
+
+/**
+ * Unused bus for standalone
+ * ReplayProtocol
+ */
+class NullBus : public Bus
+{
+public:
+  bool sendData(uint8_t* data, size_t size) override
+  {
+    (void)data;
+    (void)size;
+    throw std::logic_error("NullBus used");
+  }
+  bool waitForData(double timeout) override
+  {
+    (void)timeout;
+    return false;
+  }
+  size_t readData(uint8_t* data, size_t size) override
+  {
+    (void)data;
+    (void)size;
+    return 0;
+  }
+  void flush() override
+  {
+  }
+  void clearInputBuffer() override
+  {
+  }
+  size_t available() override
+  {
+    return 0;
+  }
+};
+
+/**
+ * Session performed identically
+ * while recording and replaying.
+ * Return read positions.
+ */
+static std::vector<float> runSession(StandardManager& manager)
+{
+  manager.scan();
+  manager.devAdd<MX28>(1, "left");
+  manager.devAdd<MX28>(2, "right");
+  assertEquals(manager.ping(1), false);
+
+  manager.flush();
+  manager.dev<MX28>(1).goalPosition().writeValue(10.0);
+  manager.dev<MX28>(2).goalPosition().writeValue(-20.0);
+  manager.flush();
+  manager.dev<MX28>(1).torqueLimit().writeValue(0.5);
+  manager.dev<MX28>(1).torqueLimit().forceWrite();
+  manager.dev<MX28>(2).position().forceRead();
+  manager.flush();
+
+  return {
+    manager.dev<MX28>(1).position().readValue().value,
+    manager.dev<MX28>(2).position().readValue().value,
+  };
+}
+
+/**
+ * Strict replay of a recorded
+ * FakeProtocol session
+ */
+static void testRoundTrip()
+{
+  std::string path = tempPath();
+  std::vector<float> recorded;
+  {
+    StandardManager manager;
+    manager.setFlightRecorder(path, 4096);
+    recorded = runSession(manager);
+  }
+
+  // Mismatching requests throw
+  // in strict (default) mode
+  StandardManager manager;
+  manager.setProtocolConfig("", 1000000, "ReplayProtocol");
+  manager.protocolParametersList().paramStr("path").value = path;
+  std::vector<float> replayed = runSession(manager);
+  assertEquals(replayed.size(), recorded.size());
+  for (size_t i = 0; i < recorded.size(); i++)
+  {
+    assertEquals(replayed[i], recorded[i]);
+  }
+  assertEquals(manager.devContainer().size(), (size_t)2);
+  std::remove(path.c_str());
+}
+
+/**
+ * Replay of a scan with only
+ * one answering Device
+ */
+static void testScan()
+{
+  std::string path = tempPath();
+  {
+    FlightRecorder recorder;
+    TimePoint origin = getTimePoint();
+    recorder.open(path, 1024, origin);
+    data_t dummy = 0;
+    for (RhAL::id_t id = IdDevBegin; id <= IdDevEnd; id++)
+    {
+      ResponseState state = (id == 1) ? (ResponseState)ResponseOK : (ResponseState)ResponseQuiet;
+      recorder.append(FlightRecordPing | FlightRecordForced, 0, id, 0, &dummy, 0, state, getTimePoint(),
+                      TimeDurationMicro(0));
+      if (id == 1)
+      {
+        type_t typeNumber = ImplManager<MX28>::typeNumber();
+        data_t type[2] = { (data_t)(typeNumber & 0xFF), (data_t)(typeNumber >> 8) };
+        recorder.append(FlightRecordForced, 0, id, AddrDevTypeNumber, type, 2, ResponseOK, getTimePoint(),
+                        TimeDurationMicro(0));
+      }
+    }
+  }
+
+  StandardManager manager;
+  manager.setProtocolConfig("", 1000000, "ReplayProtocol");
+  manager.protocolParametersList().paramStr("path").value = path;
+  manager.scan();
+  assertEquals(manager.devContainer().size(), (size_t)1);
+  assertEquals(manager.devExistsById(1), true);
+  assertEquals(manager.devTypeNumberById(1), ImplManager<MX28>::typeNumber());
+  assertEquals(manager.devById(1).isPresent(), true);
+
+  // Standalone playback of the same
+  // session, then mismatch counting
+  NullBus bus;
+  ReplayProtocol protocol(bus);
+  protocol.parametersList().paramStr("path").value = path;
+  assertEquals(protocol.ping(1), true);
+  uint8_t data[2] = { 0, 0 };
+  assertEquals(protocol.readData(1, AddrDevTypeNumber, data, 2), (ResponseState)ResponseOK);
+  assertEquals((type_t)(data[0] | (data[1] << 8)), ImplManager<MX28>::typeNumber());
+  for (RhAL::id_t id = 2; id <= IdDevEnd; id++)
+  {
+    assertEquals(protocol.ping(id), false);
+  }
+  assertEquals(protocol.isFinished(), true);
+  assertEquals(protocol.countMismatches(), (unsigned long)0);
+
+  protocol.parametersList().paramBool("strict").value = false;
+  protocol.rewind();
+  assertEquals(protocol.ping(2), false);
+  assertEquals(protocol.countMismatches() > 0, true);
+  std::remove(path.c_str());
+}
+
+int main()
+{
+  testRoundTrip();
+  testScan();
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
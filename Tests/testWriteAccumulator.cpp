@@ -0,0 +1,88 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "RhAL.hpp"
+#include "tests.h"
+
+using namespace RhAL;
+
+/**
+ * Write given values concurrently, one
+ * thread per values list, then flush
+ */
+static void writeThreads(StandardManager& manager, TypedRegisterFloat& reg,
+                         const std::vector<std::vector<float>>& values)
+{
+  std::vector<std::thread> threads;
+  for (const std::vector<float>& list : values)
+  {
+    threads.emplace_back([&reg, &list]() {
+      for (float value : list)
+      {
+        reg.writeValue(value);
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+  assertEquals(reg.needWrite(), true);
+  manager.flush();
+  assertEquals(reg.needWrite(), false);
+}
+
+int main()
+{
+  StandardManager manager;
+  manager.setScheduleMode(true);
+  manager.devAdd<MX28>(1, "dev");
+  MX28& dev = manager.dev<MX28>(1);
+  manager.flush();
+
+  // Sum over more threads than accumulators
+  TypedRegisterFloat& sum = dev.goalPosition();
+  sum.setAggregationPolicy(AggregateSum);
+  sum.enableWriteAccumulators();
+  writeThreads(manager, sum, std::vector<std::vector<float>>(2 * WriteAccumulatorsCount,
+                                                             std::vector<float>(1000, 0.25f)));
+  assertEquals(sum.getWrittenValue(), 4000.0f);
+  // Merged values are not aggregated again
+  writeThreads(manager, sum, { { 0.5f }, { 0.5f } });
+  assertEquals(sum.getWrittenValue(), 1.0f);
+
+  // Max and min
+  TypedRegisterFloat& max = dev.goalSpeed();
+  max.setAggregationPolicy(AggregateMax);
+  max.enableWriteAccumulators();
+  writeThreads(manager, max, { { 1.0f, 5.0f, 2.0f }, { 3.0f, 4.0f }, { -1.0f } });
+  assertEquals(max.getWrittenValue(), 5.0f);
+  TypedRegisterFloat& min = dev.punch();
+  min.setAggregationPolicy(AggregateMin);
+  min.enableWriteAccumulators();
+  writeThreads(manager, min, { { 1.0f, 5.0f, 2.0f }, { 3.0f, 0.5f }, { 4.0f } });
+  assertEquals(min.getWrittenValue(), 0.5f);
+
+  // First and last are ordered by write
+  // timestamp across accumulators
+  TypedRegisterFloat& last = dev.torqueLimit();
+  last.enableWriteAccumulators();
+  std::thread firstWriter([&last]() { last.writeValue(0.2f); });
+  firstWriter.join();
+  last.writeValue(0.7f);
+  manager.flush();
+  assertEquals(last.getWrittenValue(), 0.7f);
+
+  TypedRegisterFloat& first = dev.maxTorque();
+  first.setAggregationPolicy(AggregateFirst);
+  first.enableWriteAccumulators();
+  std::thread secondWriter([&first]() { first.writeValue(0.2f); });
+  secondWriter.join();
+  first.writeValue(0.7f);
+  manager.flush();
+  assertEquals(first.getWrittenValue(), 0.2f);
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}